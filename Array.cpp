@@ -8,30 +8,48 @@
  */
 
 #include "Array.h"
+#include "QuickProfile.h"
+#include <thread>
+#include <vector>
+
+// The recursion depth is kept only for the memory table and the quick sort trace.
+#if defined (MEMORY_PROFILE) || defined (QUICKSORT_PROFILE)
+#define TRACK_DEPTH
+#endif
 
 /**
  * @brief       The constructor for the array is informed of the desired size and ordering of the data. 
  *				This will allow the sorting algorithms to be compared across both dimensions.
+ *				A key range squeezes the values into [0, keyRange) so that the effect of
+ *				duplicate keys can be measured too.
  *
  * @param        newSize     	the desired size of array
  * @param        order     		the enem desired order of the data
+ * @param        keyRange     	the number of distinct keys; 0 keeps 0..999 for random
+ *								data and distinct keys for ordered data
 **/
-Array::Array (int newSize, int order)
+Array::Array (int newSize, int order, int keyRange)
 {
 	size = newSize;
+	capacity = size;
+	depth = 0;
+	maxDepth = 0;
+	moves = 0;
+	owned = true;
 	data = new int [size];
 	for (int i = 0; i < size; i++)
 	{
 		switch (order)
 		{
 			case RANDOM:
-				data[i] = rand()%1000;
+				data[i] = rand() % (keyRange > 0 ? keyRange : 1000);
 				break;
 			case IN_ORDER:
-				data[i] = i;
+				data[i] = (keyRange > 0) ? (int) ((long long) i * keyRange / size) : i;
 				break;
 			case REVERSE_ORDER:
-				data[i] = size - (i + 1);
+				data[i] = (keyRange > 0) ? (int) ((long long) (size - (i + 1)) * keyRange / size)
+										 : size - (i + 1);
 				break;
 		}	// end switch
 	}	// end for loop
@@ -45,18 +63,61 @@ Array::Array (int newSize, int order)
 Array::Array (const Array& original)
 {
 	size = original.size;
+	capacity = size;
+	depth = 0;
+	maxDepth = 0;
+	moves = 0;
+	owned = true;
 	data = new int [size];
 
 	for (int i = 0; i < size; i++)	// deep copy
 		data[i] = original.data[i];
 }	// end method
 
+/**
+ * @brief       This constructor copies size raw values, e.g. a bucket of a larger array.
+ *
+ * @param        values     	the values to be copied
+ * @param        newSize     	the number of values
+**/
+Array::Array (const int* values, int newSize)
+{
+	size = newSize;
+	capacity = size;
+	depth = 0;
+	maxDepth = 0;
+	moves = 0;
+	owned = true;
+	data = new int [size];
+	memcpy (data, values, size * sizeof (int));
+}	// end method
+
+/**
+ * @brief       This constructor wraps size values owned by the caller, e.g. a buffer
+ *				shared with another process. The sorts work on them in place and the
+ *				destructor leaves them alone; growing the array first copies them.
+ *
+ * @param        values     	the values to be sorted in place
+ * @param        newSize     	the number of values
+**/
+Array::Array (int* values, int newSize, BORROW)
+{
+	size = newSize;
+	capacity = size;
+	depth = 0;
+	maxDepth = 0;
+	moves = 0;
+	owned = false;
+	data = values;
+}	// end method
+
 /**
  * @brief       Destructor will free the memory allocated by array data
 **/
 Array::~Array()
 {
-	delete [] data;
+	if (owned)
+		delete [] data;
 }	// end method
 
 /**
@@ -70,15 +131,15 @@ void Array::write (const string& sortName,
 				   const string& orderName, 
 				   ostream& outfile) const
 {
-	outfile << "\nThe sort name: " << sortName << endl;
-	outfile << "The order name: " << orderName << endl;
+	outfile << "\nThe sort name: " << sortName << '\n';
+	outfile << "The order name: " << orderName << '\n';
 	outfile << "The array info:\n";
 	for (int i = 0; i < size; i++)
 	{
 		outfile << '\t' << data[i];
 		// display every 10 elements per line.
 		if (i % 10 == 9)
-			outfile << endl;
+			outfile << '\n';	// no flush per line
 	}	// end writing elements od data
 	outfile << endl;
 }	// end method
@@ -93,6 +154,189 @@ int Array::getSize () const
 	return size;
 }	// end method
 
+/**
+ * @brief       getValue () will return the element stored at a given position
+ *
+ * @param        index     		the position of the element
+ *
+ * @return  	the value of the element at index
+**/
+int Array::getValue (int index) const
+{
+	return data[index];
+}	// end method
+
+/**
+ * @brief       copyTo () writes all the elements to destination
+ *
+ * @param[out]   destination     room for getSize() values
+**/
+void Array::copyTo (int* destination) const
+{
+	memcpy (destination, data, size * sizeof (int));
+}	// end method
+
+/**
+ * @brief       copyFrom () overwrites all the elements with the values in source
+ *
+ * @param        source     	getSize() values
+**/
+void Array::copyFrom (const int* source)
+{
+	memcpy (data, source, size * sizeof (int));
+}	// end method
+
+// Arrays at least this long are verified by several threads.
+const int PARALLEL_VERIFY = 1 << 20;
+
+/**
+ * @brief       verifyThreads() splits size elements into chunks for the
+ *				verification scans: one per hardware thread for large arrays.
+ *
+ * @param        size     	the number of elements
+**/
+static int verifyThreads (int size)
+{
+	int threads = (int) std::thread::hardware_concurrency();
+	if (size < PARALLEL_VERIFY || threads < 2)
+		return 1;
+	return threads;
+}	// end function
+
+/**
+ * @brief       isSorted() checks that no element is larger than the next one.
+ *				The inner loop has no early exit and no branch, so the compiler
+ *				can vectorize it; large arrays are split over several threads.
+ *
+ * @return  	true if the array is in ascending order
+**/
+bool Array::isSorted () const
+{
+	int threads = verifyThreads (size);
+	std::vector<char> bad (threads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++)
+	{
+		int first = (int) ((long long) (size - 1) * t / threads);
+		int last = (int) ((long long) (size - 1) * (t+1) / threads);
+		char* result = &bad[t];
+		const int* values = data;
+		auto scan = [=] ()
+		{
+			int descents = 0;
+			for (int i = first; i < last; i++)	// pairs (i, i+1); chunks share their ends
+				descents |= values[i] > values[i+1];
+			*result = (char) descents;
+		};
+		if (threads == 1)
+			scan();
+		else
+			workers.push_back (std::thread (scan));
+	}	// end for
+	for (int t = 0; t < (int) workers.size(); t++)
+		workers[t].join();
+	for (int t = 0; t < threads; t++)
+		if (bad[t])
+			return false;
+	return true;
+}	// end method
+
+/**
+ * @brief       multisetHash() is a hash of the values that ignores their order:
+ *				the sum of a 64-bit mix (the splitmix64 step) of each value.
+ *				A sort must leave it unchanged, so comparing it before and after
+ *				catches lost, duplicated or corrupted elements.
+ *
+ * @return  	the hash of the multiset of values
+**/
+unsigned long long Array::multisetHash () const
+{
+	int threads = verifyThreads (size);
+	std::vector<unsigned long long> sums (threads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++)
+	{
+		int first = (int) ((long long) size * t / threads);
+		int last = (int) ((long long) size * (t+1) / threads);
+		unsigned long long* result = &sums[t];
+		const int* values = data;
+		auto scan = [=] ()
+		{
+			unsigned long long sum = 0;
+			for (int i = first; i < last; i++)
+			{
+				unsigned long long x = (unsigned int) values[i] + 0x9e3779b97f4a7c15ULL;	// 0 must count too
+				x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+				x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+				sum += x ^ (x >> 31);
+			}	// end for
+			*result = sum;
+		};
+		if (threads == 1)
+			scan();
+		else
+			workers.push_back (std::thread (scan));
+	}	// end for
+	for (int t = 0; t < (int) workers.size(); t++)
+		workers[t].join();
+	unsigned long long hash = 0;
+	for (int t = 0; t < threads; t++)
+		hash += sums[t];
+	return hash;
+}	// end method
+
+/**
+ * @brief       getMaxDepth () will return the deepest recursion reached by the
+ *				sorting methods of this object so far
+ *
+ * @return  	the maximum number of nested recursive calls; -1 in a build
+ *				without -DMEMORY_PROFILE (or -DQUICKSORT_PROFILE), where the depth
+ *				is not tracked
+**/
+int Array::getMaxDepth () const
+{
+#ifdef TRACK_DEPTH
+	return maxDepth;
+#else
+	return -1;
+#endif
+}	// end method
+
+/**
+ * @brief       getMoves () will return the elements moved by the insertion sorts
+ *				of this object so far (each shift or insert counts as one)
+ *
+ * @return  	the number of element moves
+**/
+long long Array::getMoves () const
+{
+	return moves;
+}	// end method
+
+/**
+ * @brief       enter() is called at the top of every recursive method and keeps
+ *				track of the deepest nesting; leave() is called before it returns.
+ *				Without -DMEMORY_PROFILE or -DQUICKSORT_PROFILE both are empty and
+ *				inlined away, so the timed sorts carry no bookkeeping.
+**/
+void Array::enter ()
+{
+#ifdef TRACK_DEPTH
+	if (++depth > maxDepth)
+		maxDepth = depth;
+#endif
+}	// end method
+
+/**
+ * @brief       leave() undoes enter() when a recursive method returns.
+**/
+void Array::leave ()
+{
+#ifdef TRACK_DEPTH
+	depth--;
+#endif
+}	// end method
+
 /**
  * @brief       swap() method will swap two numbers.
  *
@@ -117,7 +361,7 @@ pair<double,int> Array::selectionSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 	// for each position in the array
 	for (int i = 0; i < size; i++)
 	{
@@ -139,8 +383,8 @@ pair<double,int> Array::selectionSort()
 		if (smallest_indx != i)
 			swap (data[smallest_indx], data[i]);
 	}	// end for loop of each position in the array
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -158,7 +402,7 @@ pair<double,int> Array::bubbleSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	int sink = 0;
 	bool swapOccurred;
@@ -180,8 +424,8 @@ pair<double,int> Array::bubbleSort()
 	}	// end do-while
 	while (swapOccurred);	// a swap occured this pass
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -197,7 +441,7 @@ pair<double,int> Array::insertionSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	for (int i = 1; i < size; i++)	// for each element after the first
 	{
@@ -218,8 +462,8 @@ pair<double,int> Array::insertionSort()
 		data[j+1] = save_item;
 	}	// end for loop
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -235,7 +479,7 @@ pair<double,int> Array::modifiedInsertionSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	for (int i = 1; i < size; ++i)	// for each element after the first
 	{
@@ -256,22 +500,178 @@ pair<double,int> Array::modifiedInsertionSort()
     	}
     	// insert saved element in open hole
     	data[j+1] = save_item;
+    	moves += i - loc + 1;	// the shifted elements and the insert
 	}	// end for loop
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
 
 }	// end method
 
+/**
+ * @brief       binaryInsertionSort() is the modified insertion sort without its
+ *				overheads: the insert position comes from an iterative, branch-free
+ *				search instead of the recursive binarySearch(), and the larger
+ *				elements are shifted with a single memmove(). Inserting after equal
+ *				values keeps the sort stable. It is the base case of the hybrid sorts.
+**/
+pair<double,int> Array::binaryInsertionSort()
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	comparision_count = binaryInsertionSort (0, size-1);
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       binaryInsertionSort() on the range [first, last].
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+**/
+int Array::binaryInsertionSort (int first, int last)
+{
+	int comparision_count = 0;
+	for (int i = first + 1; i <= last; i++)	// for each element after the first
+	{
+		int save_item = data[i];
+		int loc = upperBound (save_item, first, i, comparision_count);
+		memmove (&data[loc + 1], &data[loc], (i - loc) * sizeof (int));
+		data[loc] = save_item;
+		moves += i - loc + 1;	// the shifted elements and the insert
+	}	// end for loop
+	return comparision_count;
+}	// end method
+
+/**
+ * @brief       upperBound() finds the first position in [first, last) whose value
+ *				is greater than value. The range is halved a fixed number of times
+ *				and each step only chooses between two bases, which compiles to a
+ *				conditional move rather than a branch.
+ *
+ * @param        value     				the value being placed
+ * @param        first     				the first index of the sorted range
+ * @param        last     				one past the last index of the sorted range
+ * @param[out]   comparision_count     	incremented once per comparison
+**/
+int Array::upperBound (int value, int first, int last, int& comparision_count) const
+{
+	int length = last - first;
+	if (length <= 0)
+		return first;
+	const int* base = &data[first];
+	while (length > 1)
+	{
+		int half = length / 2;
+		base = (base[half] <= value) ? base + half : base;
+		length -= half;
+		comparision_count++;
+	}	// end while
+	comparision_count++;
+	return (int) (base - data) + (*base <= value);
+}	// end method
+
+/**
+ * @brief       blockInsertionSort() inserts into a list of blocks of about sqrt(n)
+ *				elements instead of one array, so an insert only shifts the rest of
+ *				its block: O(sqrt(n)) moves per element instead of O(n). The block is
+ *				found by a binary search over the block maxima and the position by
+ *				upperBound()-style search inside it. A full block is split in half.
+ *				The blocks are copied back into the array at the end. Only element
+ *				moves are counted, not the block pointer updates.
+**/
+pair<double,int> Array::blockInsertionSort()
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	if (size >= 2)
+	{
+		int blockSize = (int) sqrt ((double) size);
+		if (blockSize < 16)
+			blockSize = 16;
+		std::vector<int*> blocks;	// in order; each holds counts[b] sorted values
+		std::vector<int> counts;
+		blocks.push_back (new int [blockSize]);
+		counts.push_back (0);
+		for (int i = 0; i < size; i++)
+		{
+			int save_item = data[i];
+			// the first block whose largest value is greater; the last block otherwise
+			int lo = 0, hi = (int) blocks.size() - 1;
+			while (lo < hi)
+			{
+				int mid = (lo + hi) / 2;
+				comparision_count++;
+				if (blocks[mid][counts[mid] - 1] <= save_item)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}	// end while
+			int b = lo;
+			if (counts[b] == blockSize)	// full: move the upper half to a new block
+			{
+				int half = blockSize / 2;
+				int* upper = new int [blockSize];
+				memcpy (upper, &blocks[b][half], (blockSize - half) * sizeof (int));
+				moves += blockSize - half;
+				blocks.insert (blocks.begin() + b + 1, upper);
+				counts.insert (counts.begin() + b + 1, blockSize - half);
+				counts[b] = half;
+				comparision_count++;
+				if (blocks[b][half - 1] <= save_item)
+					b++;
+			}	// end if
+			int* block = blocks[b];
+			int length = counts[b], loc = 0;
+			while (length > 0)		// branch-free upper bound in the block
+			{
+				int step = length / 2;
+				comparision_count++;
+				bool after = block[loc + step] <= save_item;
+				loc = after ? loc + step + 1 : loc;
+				length = after ? length - step - 1 : step;
+			}	// end while
+			memmove (&block[loc + 1], &block[loc], (counts[b] - loc) * sizeof (int));
+			block[loc] = save_item;
+			moves += counts[b] - loc + 1;	// the shifted elements and the insert
+			counts[b]++;
+		}	// end for
+		int indx = 0;
+		for (int b = 0; b < (int) blocks.size(); b++)	// copy the blocks back
+		{
+			memcpy (&data[indx], blocks[b], counts[b] * sizeof (int));
+			indx += counts[b];
+			delete [] blocks[b];
+		}	// end for
+		moves += size;
+	}	// end if
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
 /**
  * @brief       binarySearch() will find the right location for the consider element
  *				It supports the modified insertion sort above
 **/
 pair<int,int> Array::binarySearch(int value, int first, int last)
 {
+	enter();
 	pair<int,int> record;
 	int comparision_count = 0;
 
@@ -289,6 +689,7 @@ pair<int,int> Array::binarySearch(int value, int first, int last)
 		comparision_count +=  record.second;
 	}
 	record.second = comparision_count;
+	leave();
 	return record;
 }	// end method
 
@@ -300,12 +701,12 @@ pair<double,int> Array::mergeSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	comparision_count = mergeSort (0, size-1);
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -320,6 +721,7 @@ pair<double,int> Array::mergeSort()
 **/
 int Array::mergeSort(int first, int last)
 {
+	enter();
 	int comparision_count = 0;
 	if (last - first > 0)// more than one in subarray
 	{
@@ -328,6 +730,7 @@ int Array::mergeSort(int first, int last)
 		comparision_count += mergeSort (mid+1, last);
 		comparision_count += merge (first, last);
 	}	// end if
+	leave();
 	return comparision_count;
 }	// end method
 
@@ -404,15 +807,15 @@ pair<double,int> Array::quickSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	if (size >= 2)	// there is no need to sort if the array contains only one element
 	{
 		comparision_count = quickSort (0, size-1); // kicks of a series of recursions.
 	}	// end if
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -429,36 +832,56 @@ pair<double,int> Array::quickSort()
 **/
 int Array::quickSort(int first, int last)
 {
+	enter();
+	QS_PROFILE (QuickProfile::current().call (depth));
 	int comparision_count = 0;
 
 	if (first < last)
 	{
-		int pivot_index = last;
-		int pivot_value = data[pivot_index];			// pivot value for easy reference
-		
-		pivot_index = first;							// start looking for "correct" location
-		
-		for (int i = first; i < last; ++i)				// by scanning the entire array
-		{
-			comparision_count++;
-			if (data[i] < pivot_value)					// if value smaller than pivot is found
-			{
-				swap(data[i], data[pivot_index]);		// swap it into first partition
-				pivot_index++;							// and move the dividing point
-			}
-		}
-		
-		swap(data[pivot_index], data[last]);			// swap pivot into its correct location
-		int mid = pivot_index;
+		QS_PROFILE (std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
+		int mid = partition (first, last, comparision_count);	// pivot is the last element
+		QS_PROFILE (QuickProfile::current().split (depth, mid - first, last - mid, start));
 		
 		comparision_count += quickSort(first, mid-1);
 		comparision_count += quickSort(mid+1, last);
 	}
 
+	leave();
 	return comparision_count;
 
 }	// end method
 
+/**
+ * @brief       partition() is the partition step shared by the quick sorts and the
+ *				selection methods. The last element is the pivot; every smaller value
+ *				is swapped into the first part and the pivot is then dropped between
+ *				the two parts.
+ *
+ * @param        first     				the first index of array
+ * @param        last     				the last index of array (holds the pivot)
+ * @param[out]   comparision_count     	incremented once per comparison
+ *
+ * @return  	the final index of the pivot
+**/
+int Array::partition (int first, int last, int& comparision_count)
+{
+	int pivot_value = data[last];					// pivot value for easy reference
+	int pivot_index = first;						// start looking for "correct" location
+	
+	for (int i = first; i < last; ++i)				// by scanning the entire array
+	{
+		comparision_count++;
+		if (data[i] < pivot_value)					// if value smaller than pivot is found
+		{
+			swap(data[i], data[pivot_index]);		// swap it into first partition
+			pivot_index++;							// and move the dividing point
+		}
+	}
+	
+	swap(data[pivot_index], data[last]);			// swap pivot into its correct location
+	return pivot_index;
+}	// end method
+
 /**
  * @brief       quickSort public method will sort the whole array  
  *				based on a series of recursions which devided array into 2 parts
@@ -468,15 +891,15 @@ pair<double,int> Array::randomizedQuickSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	if (size >= 2)	// there is no need to sort if the array contains only one element
 	{
 		comparision_count = randomizedQuickSort (0, size-1); // kicks of a series of recursions.
 	}	// end if
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -493,37 +916,162 @@ pair<double,int> Array::randomizedQuickSort()
 **/
 int Array::randomizedQuickSort(int first, int last)
 {
+	enter();
+	QS_PROFILE (QuickProfile::current().call (depth));
 	int comparision_count = 0;
 	if (first < last)
 	{
+		QS_PROFILE (std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
 		int pivot_index = first + (rand() % (last-first+1));
 														// random
-		int pivot_value = data[pivot_index];			// pivot value for easy reference
 
 		swap (data[pivot_index], data[last]);			// move pivot to end (out of the way)
 		
-		pivot_index = first;							// start looking for "correct" location
-		
-		for (int i = first; i < last; ++i)				// by scanning the entire array
-		{
-			comparision_count++;
-			if (data[i] < pivot_value)					// if value smaller than pivot is found
-			{
-				swap(data[i], data[pivot_index]);		// swap it into first partition
-				pivot_index++;							// and move the dividing point
-			}
-		}
-		
-		swap(data[pivot_index], data[last]);			// swap pivot into its correct location
-		int mid = pivot_index;
+		int mid = partition (first, last, comparision_count);
+		QS_PROFILE (QuickProfile::current().split (depth, mid - first, last - mid, start));
 		
 		comparision_count += randomizedQuickSort(first, mid-1);			// quicksort everything left of division
 		comparision_count += randomizedQuickSort(mid+1, last);				// quicksort everything right of division
 	}
 	
+	leave();
+	return comparision_count;
+}	// end method
+
+/**
+ * @brief       hybridQuickSort() is quick sort with a median-of-three pivot that
+ *				leaves ranges of at most cutoff elements to binary insertion sort.
+ *				It always recurses into the smaller part, so the stack stays
+ *				O(log n) deep even when the splits are poor.
+ *
+ * @param        cutoff     	the largest range handed to binary insertion sort, at least 1
+**/
+pair<double,int> Array::hybridQuickSort(int cutoff)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	if (cutoff < 1)
+		cutoff = 1;
+	if (size >= 2)
+	{
+		comparision_count = hybridQuickSort (0, size-1, cutoff);
+	}	// end if
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       The recursive portion of hybridQuickSort().
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+ * @param        cutoff     	the largest range handed to binary insertion sort
+**/
+int Array::hybridQuickSort (int first, int last, int cutoff)
+{
+	enter();
+	int comparision_count = 0;
+	while (last - first + 1 > cutoff)
+	{
+		comparision_count += medianOfThree (first, last);
+		int mid = partition (first, last, comparision_count);
+		if (mid - first < last - mid)	// recurse into the smaller part
+		{
+			comparision_count += hybridQuickSort (first, mid-1, cutoff);
+			first = mid + 1;
+		}
+		else
+		{
+			comparision_count += hybridQuickSort (mid+1, last, cutoff);
+			last = mid - 1;
+		}	// end else
+	}	// end while
+	comparision_count += binaryInsertionSort (first, last);
+	leave();
+	return comparision_count;
+}	// end method
+
+/**
+ * @brief       hybridMergeSort() is merge sort that binary insertion sorts blocks
+ *				of at most block elements instead of recursing down to single elements.
+ *
+ * @param        block     		the largest range handed to binary insertion sort, at least 1
+**/
+pair<double,int> Array::hybridMergeSort(int block)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	if (block < 1)
+		block = 1;
+	comparision_count = hybridMergeSort (0, size-1, block);
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       The recursive portion of hybridMergeSort().
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+ * @param        block     		the largest range handed to binary insertion sort
+**/
+int Array::hybridMergeSort (int first, int last, int block)
+{
+	enter();
+	int comparision_count = 0;
+	if (last - first + 1 <= block)
+		comparision_count = binaryInsertionSort (first, last);
+	else
+	{
+		int mid = (first + last) / 2;
+		comparision_count = hybridMergeSort (first, mid, block);
+		comparision_count += hybridMergeSort (mid+1, last, block);
+		comparision_count += merge (first, last);
+	}	// end else
+	leave();
 	return comparision_count;
 }	// end method
 
+/**
+ * @brief       sortBy() sorts the array with the engine given by its enum, for the
+ *				callers that pick the engine at run time.
+ *
+ * @param        sortType    	the enum which evokes the type of sort method (not AUTO)
+ * @param        cutoff    		the cutoff for the hybrid sorts
+**/
+pair<double,int> Array::sortBy(int sortType, int cutoff)
+{
+	pair<double,int> record;
+	switch (sortType)
+	{
+		case SELECTION:		record = selectionSort();			break;
+		case BUBBLE:		record = bubbleSort();				break;
+		case INSERTION:		record = insertionSort();			break;
+		case MODINSERTION:	record = modifiedInsertionSort();	break;
+		case MERGE:			record = mergeSort();				break;
+		case QUICK:			record = quickSort();				break;
+		case RANQUICK:		record = randomizedQuickSort();		break;
+		case HEAP:			record = heapSort();				break;
+		case HYBRIDQUICK:	record = hybridQuickSort(cutoff);	break;
+		case HYBRIDMERGE:	record = hybridMergeSort(cutoff);	break;
+		case BININSERTION:	record = binaryInsertionSort();		break;
+		case BLOCKINSERTION:record = blockInsertionSort();		break;
+	}	// end switch
+	return record;
+}	// end method
+
 /**
  * @brief       The heap sort uses the heap data structure 
  *				introduced in implementing the priority queue.
@@ -533,7 +1081,7 @@ pair<double,int> Array::heapSort()
 {
 	pair<double,int> record;
 	int comparision_count = 0;
-	clock_t start = clock();	// save the starting time
+	double start = threadClock();	// save the starting time
 
 	for (int i = size/2 - 1; i >= 0; i--) // max heapify
 	{
@@ -546,8 +1094,8 @@ pair<double,int> Array::heapSort()
 		comparision_count += moveDownHeap (0, n-1);
 	}	// end for
 
-	clock_t finish = clock();	// save the ending time
-	double time = (finish - start) * 1.0 / CLOCKS_PER_SEC;	// the time of sort execution.
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
 	record.first = time;
 	record.second = comparision_count;
 	return record;
@@ -594,4 +1142,385 @@ int Array::moveDownHeap (int first, int last)
 		}	// end else left child is present
 	}	// end while loop
 	return comparision_count;
-}	// end method
\ No newline at end of file
+}	// end method
+
+/**
+ * @brief       nthElement() puts the k-th smallest value at index k, with nothing
+ *				larger before it and nothing smaller after it. It is an introselect:
+ *				quick sort partitioning with a median-of-three pivot, recursing only
+ *				into the side holding k, and falling back to merge sort on the
+ *				remaining range when the partitions keep coming out unbalanced.
+ *
+ * @param        k     		the rank (0-based) to be selected
+**/
+pair<double,int> Array::nthElement(int k)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	if (size >= 2 && k >= 0 && k < size)
+	{
+		int depthLimit = 2 * (int) log2 ((double) size);
+		comparision_count = select (0, size-1, k, depthLimit);
+	}	// end if
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       partialSort() moves the k smallest values into the first k positions
+ *				in ascending order. A max heap of the first k values is built with
+ *				moveDownHeap(); every later value smaller than the root replaces it.
+ *				The heap is sorted in place at the end, as in heapSort().
+ *
+ * @param        k     		the number of smallest values wanted, clamped to [0, size]
+**/
+pair<double,int> Array::partialSort(int k)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	if (k < 0)
+		k = 0;
+	if (k > size)
+		k = size;
+	for (int i = k/2 - 1; i >= 0; i--) // max heapify the first k elements
+	{
+		comparision_count += moveDownHeap (i, k-1);
+	}
+
+	for (int i = k; i < size; i++)	// keep the k smallest seen so far
+	{
+		comparision_count++;
+		if (data[i] < data[0])	// smaller than the largest kept value
+		{
+			swap (data[0], data[i]);
+			comparision_count += moveDownHeap (0, k-1);
+		}	// end if
+	}	// end for
+
+	for (int n = k-1; n >= 1; n--)	// sort the kept values
+	{
+		swap (data[0], data[n]);
+		comparision_count += moveDownHeap (0, n-1);
+	}	// end for
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       quantiles() selects several ranks in one pass: after each partition
+ *				the requested ranks are split around the pivot and only the sides
+ *				that still hold a rank are visited. Afterwards getValue(ranks[i])
+ *				returns the ranks[i]-th smallest value.
+ *
+ * @param[out]   ranks     		the ranks (0-based) to be selected, sorted in place
+ * @param        count     		the number of ranks
+**/
+pair<double,int> Array::quantiles(int* ranks, int count)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	for (int i = 1; i < count; i++)	// put the ranks in order (there are only a few)
+	{
+		int save_item = ranks[i];
+		int j = i-1;
+		while (j >= 0 && ranks[j] > save_item)
+		{
+			ranks[j+1] = ranks[j];
+			j--;
+		}
+		ranks[j+1] = save_item;
+	}	// end for loop
+
+	if (size >= 2 && count > 0)
+	{
+		int depthLimit = 2 * (int) log2 ((double) size);
+		comparision_count = multiSelect (0, size-1, ranks, 0, count-1, depthLimit);
+	}	// end if
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       medianOfThree() moves the median of the first, middle and last
+ *				elements to the last position, where partition() expects the pivot.
+ *				This keeps in-order and reverse-order data from going quadratic.
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+ *
+ * @return  	the number of comparisons
+**/
+int Array::medianOfThree (int first, int last)
+{
+	int mid = (first + last) / 2;
+	if (data[mid] < data[first])
+		swap (data[mid], data[first]);
+	if (data[last] < data[first])
+		swap (data[last], data[first]);
+	if (data[mid] < data[last])		// the median is the smaller of the other two
+		swap (data[mid], data[last]);
+	return 3;
+}	// end method
+
+/**
+ * @brief       select() is the iterative portion of nthElement(). Once the depth
+ *				limit runs out the range is sorted with mergeSort(first, last),
+ *				which bounds the worst case to O(n log n).
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+ * @param        k     			the rank to be selected
+ * @param        depthLimit     the number of partitions allowed before falling back
+**/
+int Array::select (int first, int last, int k, int depthLimit)
+{
+	int comparision_count = 0;
+	while (first < last)
+	{
+		if (depthLimit == 0)	// too many bad splits
+		{
+			comparision_count += mergeSort (first, last);
+			break;
+		}	// end if
+		depthLimit--;
+		comparision_count += medianOfThree (first, last);
+		int mid = partition (first, last, comparision_count);
+		if (k == mid)
+			break;
+		else if (k < mid)
+			last = mid - 1;
+		else
+			first = mid + 1;
+	}	// end while
+	return comparision_count;
+}	// end method
+
+/**
+ * @brief       multiSelect() is the recursive portion of quantiles(). Only the
+ *				ranks between lo and hi (inclusive) fall inside [first, last].
+ *
+ * @param        first     		the first index of array
+ * @param        last     		the last index of array
+ * @param        ranks     		the sorted ranks
+ * @param        lo     		the first rank of this range
+ * @param        hi     		the last rank of this range
+ * @param        depthLimit     the number of partitions allowed before falling back
+**/
+int Array::multiSelect (int first, int last, int* ranks, int lo, int hi, int depthLimit)
+{
+	enter();
+	int comparision_count = 0;
+	if (first < last && lo <= hi)
+	{
+		if (depthLimit == 0)	// too many bad splits
+			comparision_count = mergeSort (first, last);
+		else
+		{
+			comparision_count += medianOfThree (first, last);
+			int mid = partition (first, last, comparision_count);
+			// ranks [lo, split) go left of the pivot, ranks after the pivot go right
+			int split = lo;
+			while (split <= hi && ranks[split] < mid)
+				split++;
+			int right = split;
+			while (right <= hi && ranks[right] == mid)
+				right++;
+			comparision_count += multiSelect (first, mid-1, ranks, lo, split-1, depthLimit-1);
+			comparision_count += multiSelect (mid+1, last, ranks, right, hi, depthLimit-1);
+		}	// end else
+	}	// end if
+	leave();
+	return comparision_count;
+}	// end method
+
+
+/**
+ * @brief       mergeBatch() adds a batch of new values to this already sorted array
+ *				and keeps it sorted, without sorting the old values again. Only the
+ *				batch is sorted; it is then merged from the back into the grown
+ *				array. For each batch value (largest first) a galloping search walks
+ *				left from the current position, so a small batch costs about
+ *				m log(n/m) comparisons and one block move per batch value.
+ *				Equal values keep the old ones first.
+ *
+ * @param        batch     		the new values, in any order
+**/
+pair<double,int> Array::mergeBatch(const Array& batch)
+{
+	pair<double,int> record;
+	int comparision_count = 0;
+	double start = threadClock();	// save the starting time
+
+	Array sorted (batch);
+	comparision_count = sorted.mergeSort().second;
+
+	int i = size;				// old values [0, i) are not placed yet
+	grow (size + sorted.size);
+	int k = size;				// [k, size) is already merged
+	for (int j = sorted.size - 1; j >= 0; j--)
+	{
+		int value = sorted.data[j];
+		int pos = gallop (value, i, comparision_count);	// old values from pos on are larger
+		int count = i - pos;
+		memmove (&data[k - count], &data[pos], count * sizeof (int));
+		k -= count;
+		i = pos;
+		data[--k] = value;
+	}	// end for, old values [0, i) are already in place
+
+	double finish = threadClock();	// save the ending time
+	double time = finish - start;	// the time of sort execution.
+	record.first = time;
+	record.second = comparision_count;
+	return record;
+}	// end method
+
+/**
+ * @brief       append() adds a batch of new values after the current ones without
+ *				sorting anything.
+ *
+ * @param        batch     		the new values
+**/
+void Array::append(const Array& batch)
+{
+	int oldSize = size;
+	int count = batch.size;		// read before grow() when batch is this array
+	grow (size + count);
+	// a self-append copies the old values, which grow() kept at the front
+	memcpy (&data[oldSize], (&batch == this) ? data : batch.data, count * sizeof (int));
+}	// end method
+
+/**
+ * @brief       lowerBound() finds the first position whose value is not less than
+ *				value in this sorted array; size if there is none.
+ *
+ * @param        value     		the value looked for
+**/
+int Array::lowerBound(int value) const
+{
+	int first = 0, last = size;
+	while (first < last)
+	{
+		int mid = first + (last - first) / 2;
+		if (data[mid] < value)
+			first = mid + 1;
+		else
+			last = mid;
+	}	// end while
+	return first;
+}	// end method
+
+/**
+ * @brief       upperBound() finds the first position whose value is greater than
+ *				value in this sorted array; size if there is none. The values in
+ *				[low, high] are at positions lowerBound(low) to upperBound(high) - 1.
+ *
+ * @param        value     		the value looked for
+**/
+int Array::upperBound(int value) const
+{
+	int first = 0, last = size;
+	while (first < last)
+	{
+		int mid = first + (last - first) / 2;
+		if (data[mid] <= value)
+			first = mid + 1;
+		else
+			last = mid;
+	}	// end while
+	return first;
+}	// end method
+
+/**
+ * @brief       grow() sets the size to newSize, doubling the capacity when it runs
+ *				out so that a series of appends costs amortized O(1) per element.
+ *				A view moves into memory of its own at that point.
+ *
+ * @param        newSize     	the new size of array
+**/
+void Array::grow (int newSize)
+{
+	if (newSize > capacity)
+	{
+		int newCapacity = (capacity * 2 > newSize) ? capacity * 2 : newSize;
+		int* larger = new int [newCapacity];
+		memcpy (larger, data, size * sizeof (int));
+		if (owned)
+			delete [] data;
+		data = larger;
+		owned = true;
+		capacity = newCapacity;
+	}	// end if
+	size = newSize;
+}	// end method
+
+/**
+ * @brief       gallop() finds the first position in [0, last) whose value is greater
+ *				than value. It steps left from last by 1, 2, 4, ... until it passes
+ *				value and then binary searches the final step, so the cost grows
+ *				with the log of the distance rather than of last.
+ *
+ * @param        value     				the value being placed
+ * @param        last     				the end of the sorted range
+ * @param[out]   comparision_count     	incremented once per comparison
+**/
+int Array::gallop (int value, int last, int& comparision_count) const
+{
+	int hi = last;			// everything from hi on is greater than value
+	int lo = hi - 1;
+	int step = 1;
+	while (lo >= 0)
+	{
+		comparision_count++;
+		if (data[lo] <= value)
+			break;
+		hi = lo;
+		step *= 2;
+		lo = hi - step;
+	}	// end while
+	if (lo < 0)
+		lo = -1;
+	while (hi - lo > 1)		// data[lo] <= value < data[hi]
+	{
+		int mid = lo + (hi - lo) / 2;
+		comparision_count++;
+		if (data[mid] <= value)
+			lo = mid;
+		else
+			hi = mid;
+	}	// end while
+	return hi;
+}	// end method
+
+/**
+ * @brief       threadClock() returns the CPU time of the calling thread in seconds.
+ *				Where the thread clock is missing it falls back to clock(), which
+ *				is the same thing for a single-threaded run.
+**/
+double threadClock ()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	timespec now;
+	if (clock_gettime (CLOCK_THREAD_CPUTIME_ID, &now) == 0)
+		return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+	return clock() * 1.0 / CLOCKS_PER_SEC;
+}	// end function
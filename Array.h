@@ -23,49 +23,105 @@
 	using std::pow;
 #include <utility>
 	using std::pair;
+#include <cstring>
+	using std::memcpy;
+	using std::memmove;
+
+// Tag of the constructor that sorts someone else's memory in place instead of copying it.
+enum BORROW {BORROWED};
 
 class Array
 {
 public:
-	Array (int size, int order);	// constructor
+	Array (int size, int order, int keyRange = 0);	// constructor
 	Array (const Array& original);	// copy-constructor
+	Array (const int* values, int size);	// copy of raw values
+	Array (int* values, int size, BORROW);	// view of values owned elsewhere, sorted in place
 	~Array();						// destructor
 	void write (const string& sortName, 
 			    const string& orderName,
 			    ostream& outfile = cout) const;
 	int getSize () const;
+	int getValue (int index) const;
+	void copyTo (int* destination) const;
+	void copyFrom (const int* source);
+	int getMaxDepth () const;
+	long long getMoves () const;
+	// Verification methods
+	bool isSorted () const;
+	unsigned long long multisetHash () const;
 	// Sorting methods
 	pair<double,int> selectionSort();
 	pair<double,int> bubbleSort();
 	pair<double,int> insertionSort();
 	pair<double,int> modifiedInsertionSort();
+	pair<double,int> binaryInsertionSort();
+	pair<double,int> blockInsertionSort();
 	pair<double,int> mergeSort();
 	pair<double,int> quickSort();
 	pair<double,int> randomizedQuickSort();
 	pair<double,int> heapSort();
+	pair<double,int> hybridQuickSort(int cutoff);
+	pair<double,int> hybridMergeSort(int block);
+	pair<double,int> sortBy(int sortType, int cutoff);
+	// Selection methods
+	pair<double,int> nthElement(int k);
+	pair<double,int> partialSort(int k);
+	pair<double,int> quantiles(int* ranks, int count);
+	// Incremental methods (this array must already be sorted)
+	pair<double,int> mergeBatch(const Array& batch);
+	void append(const Array& batch);
+	int lowerBound(int value) const;
+	int upperBound(int value) const;
 	
 private:
 	// private methods
 	void swap (int& a, int& b);
+	void enter ();
+	void leave ();
 	pair<int,int> binarySearch(int value, int first, int last);
 	int moveDownHeap (int i, int n);
 	int quickSort (int first, int last);
 	int randomizedQuickSort(int first, int last);
 	int mergeSort (int first, int last);
 	int merge (int first, int last);
+	int binaryInsertionSort (int first, int last);
+	int upperBound (int value, int first, int last, int& comparision_count) const;
+	int hybridQuickSort (int first, int last, int cutoff);
+	int hybridMergeSort (int first, int last, int block);
+	int partition (int first, int last, int& comparision_count);
+	int medianOfThree (int first, int last);
+	int select (int first, int last, int k, int depthLimit);
+	int multiSelect (int first, int last, int* ranks, int lo, int hi, int depthLimit);
+	void grow (int newSize);
+	int gallop (int value, int last, int& comparision_count) const;
 
 private:
 	int* data;
 	int size;
+	int capacity;	// elements allocated in data, at least size
+	int depth;		// current recursion depth of the sorting methods
+	int maxDepth;	// deepest recursion so far
+	long long moves;	// elements moved by the insertion sorts so far
+	bool owned;		// false for a view: data belongs to the caller and is never freed
 };
 
 // With regard to the algorithm names, define an enumerated type (SORTS) and the algorithm names array (SORT NAMES).
-enum SORTS {SELECTION, BUBBLE, INSERTION, MODINSERTION, MERGE, QUICK, RANQUICK, HEAP};
-const string SORT_NAMES[8] = {"Selection    ", "Bubble       ", "Insertion    ", "Mod.Insertion",
-							  "Merge        ", "Quick        ", "Ran Quick    ", "Heap         "};
+// HYBRIDQUICK and HYBRIDMERGE take their cutoffs from the tuning profile; AUTO lets the profile pick the engine.
+// New engines go before AUTO, which stays last; saved profiles refer to engines by number.
+enum SORTS {SELECTION, BUBBLE, INSERTION, MODINSERTION, MERGE, QUICK, RANQUICK, HEAP, HYBRIDQUICK, HYBRIDMERGE,
+			BININSERTION, BLOCKINSERTION, AUTO};
+const string SORT_NAMES[13] = {"Selection    ", "Bubble       ", "Insertion    ", "Mod.Insertion",
+							   "Merge        ", "Quick        ", "Ran Quick    ", "Heap         ",
+							   "Hybrid Quick ", "Hybrid Merge ", "Bin.Insertion", "Blk.Insertion",
+							   "Auto         "};
 
 // The names of the various data orderings are handled in a fashion analagous to that of the sorting orders.
 enum ORDERS {RANDOM, IN_ORDER, REVERSE_ORDER};
 const string ORDER_NAMES[3] = {"Random ", "InOrder", "Reverse"};
 
+// CPU seconds used by the calling thread; the sorts time themselves with it, since clock()
+// would also charge them for every other thread of the process (e.g. the Scheduler's cells).
+double threadClock ();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ * @file    Complexity.cpp
+ * @brief   This file contains the implementation of the complexity model fit
+ *			and the predictions made from it.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "Complexity.h"
+#include <cmath>
+
+// Times at or below this are clock noise and are not used for the time fit.
+const double MEASURABLE = 0.0005;
+
+/**
+ * @brief       An empty model predicts nothing (zero) until a point is added.
+**/
+ComplexityModel::ComplexityModel ()
+{
+	best = QUADRATIC;
+	constant = 0;
+}	// end method
+
+/**
+ * @brief       add() records one measured cell and refits the model.
+ *
+ * @param        size     		the number of elements
+ * @param        time     		the measured seconds
+ * @param        count     		the measured comparison count
+**/
+void ComplexityModel::add (int size, double time, double count)
+{
+	sizes.push_back (size);
+	times.push_back (time);
+	comparisons.push_back (count > 1 ? count : 1);
+	fit();
+}	// end method
+
+/**
+ * @brief       getPoints () returns the number of measured cells
+**/
+int ComplexityModel::getPoints () const
+{
+	return (int) sizes.size();
+}	// end method
+
+/**
+ * @brief       getModel () returns the best-fitting model of the comparisons
+**/
+int ComplexityModel::getModel () const
+{
+	return best;
+}	// end method
+
+/**
+ * @brief       getConstant () returns c in comparisons ~= c * model(n)
+**/
+double ComplexityModel::getConstant () const
+{
+	return constant;
+}	// end method
+
+/**
+ * @brief       getExponent() is the slope of log(time) against log(n), i.e. the k
+ *				in time ~ n^k. When fewer than two times are measurable the
+ *				comparison counts are used instead.
+**/
+double ComplexityModel::getExponent () const
+{
+	vector<double> x, y;
+	for (int i = 0; i < (int) sizes.size(); i++)
+		if (times[i] > MEASURABLE)
+		{
+			x.push_back (log (sizes[i]));
+			y.push_back (log (times[i]));
+		}	// end if
+	if (x.size() < 2)
+	{
+		x.clear();
+		y.clear();
+		for (int i = 0; i < (int) sizes.size(); i++)
+		{
+			x.push_back (log (sizes[i]));
+			y.push_back (log (comparisons[i]));
+		}	// end for
+	}	// end if
+	return slope (x, y);
+}	// end method
+
+/**
+ * @brief       predictComparisons() evaluates the fitted model.
+ *
+ * @param        size     		the number of elements
+**/
+double ComplexityModel::predictComparisons (int size) const
+{
+	return constant * model (best, size);
+}	// end method
+
+/**
+ * @brief       predictTime() takes the larger of two estimates: the predicted
+ *				comparisons times the seconds per comparison of the largest
+ *				measurable cell, and the measured times grown by the time
+ *				exponent. The second catches sorts whose time is dominated by
+ *				moves rather than comparisons, like the modified insertion sort.
+ *
+ * @param        size     		the number of elements
+**/
+double ComplexityModel::predictTime (int size) const
+{
+	if (sizes.empty())
+		return 0;
+	int last = (int) sizes.size() - 1;
+	int measurable = 0;
+	for (int i = (int) sizes.size() - 1; i >= 0; i--)
+		if (times[i] > MEASURABLE)
+		{
+			if (measurable++ == 0)
+				last = i;
+		}	// end if
+	double byComparisons = predictComparisons (size) * times[last] / comparisons[last];
+	if (measurable < 2)
+		return byComparisons;
+	double byTime = times[last] * pow (size / sizes[last], getExponent());
+	return (byTime > byComparisons) ? byTime : byComparisons;
+}	// end method
+
+/**
+ * @brief       model() is the growth function of each candidate model.
+ *
+ * @param        which     		the enum of the model
+ * @param        n     			the number of elements
+**/
+double ComplexityModel::model (int which, double n)
+{
+	if (n < 2)
+		n = 2;
+	switch (which)
+	{
+		case LINEAR:
+			return n;
+		case NLOGN:
+			return n * log2 (n);
+		default:
+			return n * n;
+	}	// end switch
+}	// end method
+
+/**
+ * @brief       fit() compares the models on the log of the comparison counts:
+ *				for each model the constant is the geometric mean of
+ *				comparisons / model(n) and the error is the spread around it.
+ *				With a single point the growth is unknown, so the quadratic model
+ *				is kept as the safe guess.
+**/
+void ComplexityModel::fit ()
+{
+	int points = (int) sizes.size();
+	double bestError = -1;
+	for (int which = LINEAR; which <= QUADRATIC; which++)
+	{
+		double mean = 0;
+		for (int i = 0; i < points; i++)
+			mean += log (comparisons[i] / model (which, sizes[i]));
+		mean /= points;
+		double error = 0;
+		for (int i = 0; i < points; i++)
+		{
+			double residual = log (comparisons[i] / model (which, sizes[i])) - mean;
+			error += residual * residual;
+		}	// end for
+		if ((points == 1 && which == QUADRATIC) ||
+			(points > 1 && (bestError < 0 || error < bestError)))
+		{
+			bestError = error;
+			best = which;
+			constant = exp (mean);
+		}	// end if
+	}	// end for models
+}	// end method
+
+/**
+ * @brief       slope() is the least-squares slope of y against x (0 for fewer
+ *				than two points).
+ *
+ * @param        x     		the abscissas
+ * @param        y     		the ordinates
+**/
+double ComplexityModel::slope (const vector<double>& x, const vector<double>& y)
+{
+	int points = (int) x.size();
+	if (points < 2)
+		return 0;
+	double meanX = 0, meanY = 0;
+	for (int i = 0; i < points; i++)
+	{
+		meanX += x[i];
+		meanY += y[i];
+	}	// end for
+	meanX /= points;
+	meanY /= points;
+	double sxy = 0, sxx = 0;
+	for (int i = 0; i < points; i++)
+	{
+		sxy += (x[i] - meanX) * (y[i] - meanY);
+		sxx += (x[i] - meanX) * (x[i] - meanX);
+	}	// end for
+	return (sxx > 0) ? sxy / sxx : 0;
+}	// end method
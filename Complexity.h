@@ -0,0 +1,49 @@
+/**
+ * @file    Complexity.h
+ * @brief   A complexity model follows one (sort, order) cell across the size
+ *			sweep. It fits the comparison counts to n, n log n and n^2, turns
+ *			the fit into a time with the measured seconds per comparison, and
+ *			so predicts what the next size will cost before it is run.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef COMPLEXITY_H
+#define COMPLEXITY_H
+
+#include <string>
+	using std::string;
+#include <vector>
+	using std::vector;
+
+enum MODELS {LINEAR, NLOGN, QUADRATIC};
+const string MODEL_NAMES[3] = {"n      ", "n log n", "n^2    "};
+
+class ComplexityModel
+{
+public:
+	ComplexityModel ();
+	void add (int size, double time, double count);
+	int getPoints () const;
+	int getModel () const;
+	double getConstant () const;
+	double getExponent () const;
+	double predictComparisons (int size) const;
+	double predictTime (int size) const;
+
+	static double model (int which, double n);
+
+private:
+	void fit ();
+	static double slope (const vector<double>& x, const vector<double>& y);
+
+private:
+	vector<double> sizes;
+	vector<double> times;
+	vector<double> comparisons;
+	int best;			// the model with the smallest error
+	double constant;	// comparisons ~= constant * model(best, n)
+};
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file    Memory.cpp
+ * @brief   This file contains the replacement operator new and delete, which
+ *			keep per-thread heap counters, and the MemoryMeter that reads them.
+ *			The replacements exist only in a build with -DMEMORY_PROFILE.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "Memory.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef MEMORY_PROFILE
+
+namespace
+{
+	// Per-thread counters, so that cells measured in parallel do not mix.
+	struct Counters
+	{
+		long long live;			// bytes allocated and not yet freed
+		long long peak;			// highest value of live since the last start()
+		long long total;		// bytes ever allocated
+		long long allocations;	// calls to operator new
+	};
+	thread_local Counters counters;
+
+	// Every block carries its size in front, so delete knows how much is freed.
+	const size_t HEADER = 16;	// keeps the user block 16-byte aligned
+
+	void* allocate (size_t bytes)
+	{
+		char* block = (char*) malloc (bytes + HEADER);
+		if (!block)
+			return NULL;
+		*(size_t*) block = bytes;
+		counters.live += bytes;
+		counters.total += bytes;
+		counters.allocations++;
+		if (counters.live > counters.peak)
+			counters.peak = counters.live;
+		return block + HEADER;
+	}
+
+	void release (void* pointer)
+	{
+		if (!pointer)
+			return;
+		char* block = (char*) pointer - HEADER;
+		counters.live -= *(size_t*) block;
+		free (block);
+	}
+}
+
+void* operator new (size_t bytes)
+{
+	void* pointer = allocate (bytes);
+	if (!pointer)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[] (size_t bytes)
+{
+	return operator new (bytes);
+}
+
+void* operator new (size_t bytes, const std::nothrow_t&) noexcept
+{
+	return allocate (bytes);
+}
+
+void* operator new[] (size_t bytes, const std::nothrow_t&) noexcept
+{
+	return allocate (bytes);
+}
+
+void operator delete (void* pointer) noexcept
+{
+	release (pointer);
+}
+
+void operator delete[] (void* pointer) noexcept
+{
+	release (pointer);
+}
+
+void operator delete (void* pointer, size_t) noexcept
+{
+	release (pointer);
+}
+
+void operator delete[] (void* pointer, size_t) noexcept
+{
+	release (pointer);
+}
+
+void operator delete (void* pointer, const std::nothrow_t&) noexcept
+{
+	release (pointer);
+}
+
+void operator delete[] (void* pointer, const std::nothrow_t&) noexcept
+{
+	release (pointer);
+}
+
+#endif	// MEMORY_PROFILE
+
+/**
+ * @brief       A meter measures nothing until start() is called.
+**/
+MemoryMeter::MemoryMeter ()
+{
+	startLive = 0;
+	startRssKB = 0;
+	startPeakKB = 0;
+	peakReset = false;
+}	// end method
+
+/**
+ * @brief       start() begins a measured region on the calling thread. The
+ *				kernel's peak RSS is reset to the current RSS when allowed, so
+ *				the peak at stop() belongs to this region alone.
+**/
+void MemoryMeter::start ()
+{
+	peakReset = resetPeakRss();
+	startRssKB = readStatusKB ("VmRSS:");
+	startPeakKB = readStatusKB ("VmHWM:");
+#ifdef MEMORY_PROFILE
+	startLive = counters.live;
+	counters.peak = counters.live;
+	counters.total = 0;
+	counters.allocations = 0;
+#endif
+}	// end method
+
+/**
+ * @brief       stop() reads the counters of the region begun by start(), which
+ *				must be on the same thread. Without a peak reset only the growth
+ *				of the old peak can be seen, which is a lower bound. The heap
+ *				figures are -1 in a build without -DMEMORY_PROFILE.
+**/
+MemoryUsage MemoryMeter::stop () const
+{
+	MemoryUsage usage;
+#ifdef MEMORY_PROFILE
+	usage.peakBytes = counters.peak - startLive;
+	usage.totalBytes = counters.total;
+	usage.allocations = counters.allocations;
+#else
+	usage.peakBytes = -1;
+	usage.totalBytes = -1;
+	usage.allocations = -1;
+#endif
+	long peakKB = readStatusKB ("VmHWM:");
+	if (peakKB < 0 || startRssKB < 0)
+		usage.peakRssKB = -1;
+	else
+	{
+		usage.peakRssKB = peakKB - (peakReset ? startRssKB : startPeakKB);
+		if (usage.peakRssKB < 0)	// RSS dropped below where it started
+			usage.peakRssKB = 0;
+	}	// end else
+	return usage;
+}	// end method
+
+/**
+ * @brief       readStatusKB() reads one "kB" field of /proc/self/status.
+ *
+ * @param        field     	the field name with its colon, e.g. "VmRSS:"
+ *
+ * @return  	the value in kB, or -1 if it is not available
+**/
+long MemoryMeter::readStatusKB (const char* field)
+{
+	FILE* file = fopen ("/proc/self/status", "r");
+	if (!file)
+		return -1;
+	char line[256];
+	long value = -1;
+	size_t length = strlen (field);
+	while (fgets (line, sizeof (line), file))
+		if (strncmp (line, field, length) == 0)
+		{
+			value = atol (line + length);
+			break;
+		}	// end if
+	fclose (file);
+	return value;
+}	// end method
+
+/**
+ * @brief       resetPeakRss() asks the kernel to reset VmHWM to the current RSS.
+ *
+ * @return  	true if the reset was accepted
+**/
+bool MemoryMeter::resetPeakRss ()
+{
+	FILE* file = fopen ("/proc/self/clear_refs", "w");
+	if (!file)
+		return false;
+	bool written = fputs ("5", file) >= 0;
+	return (fclose (file) == 0) && written;
+}	// end method
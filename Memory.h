@@ -0,0 +1,48 @@
+/**
+ * @file    Memory.h
+ * @brief   Memory accounting for the benchmarks. Memory.cpp replaces the global
+ *			operator new and delete so that every heap allocation made on a
+ *			thread is counted for that thread. A MemoryMeter brackets one sort and
+ *			reports its heap peak, bytes and allocations, together with the growth
+ *			of the process's peak resident set size.
+ *
+ *			The counting allocator, like the recursion depth kept by Array, is
+ *			built only with -DMEMORY_PROFILE, so the timing tables of a normal
+ *			build do not pay for it. Without the flag only the resident set is
+ *			measured and the heap figures are -1.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+// What one measured region used.
+struct MemoryUsage
+{
+	long long peakBytes;	// highest live heap bytes above the start; -1 if not counted
+	long long totalBytes;	// bytes requested from operator new; -1 if not counted
+	long long allocations;	// calls to operator new; -1 if not counted
+	long peakRssKB;			// peak resident set growth; -1 if not available
+};
+
+class MemoryMeter
+{
+public:
+	MemoryMeter ();
+	void start ();
+	MemoryUsage stop () const;
+
+private:
+	static long readStatusKB (const char* field);
+	static bool resetPeakRss ();
+
+private:
+	long long startLive;	// live heap bytes of this thread at start()
+	long startRssKB;		// resident set size at start()
+	long startPeakKB;		// peak resident set size at start()
+	bool peakReset;			// whether the kernel's peak was reset at start()
+};
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * @file    Profile.cpp
+ * @brief   This file contains the implementation of the tuning profile: the
+ *			cutoff sweeps, the per-class engine timings and the profile file.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "Profile.h"
+#include <iomanip>
+	using std::setw;
+	using std::setprecision;
+	using std::setiosflags;
+	using std::ios;
+
+/**
+ * @brief       The default profile is what data.txt shows without any tuning:
+ *				insertion sort for the smallest class, hybrid merge sort otherwise.
+ *				In-order data also gets hybrid merge sort, as the order class lets
+ *				through data that is only 90% in order.
+**/
+Profile::Profile ()
+{
+	insertionCutoff = 16;
+	mergeBlock = 32;
+	for (int s = 0; s < SIZE_CLASSES; s++)
+		for (int o = RANDOM; o <= REVERSE_ORDER; o++)
+			for (int r = NARROW; r <= WIDE; r++)
+				engine[s][o][r] = (s == 0) ? INSERTION : HYBRIDMERGE;
+}	// end method
+
+/**
+ * @brief       load() reads a profile written by save(). Unknown or out of range
+ *				lines are ignored, so a damaged file degrades to the defaults. So is
+ *				an engine that is not bounded() for a class above the smallest,
+ *				which older profiles may hold.
+ *
+ * @param        fileName     	the name of the profile file
+ *
+ * @return  	true if the file could be opened
+**/
+bool Profile::load (const string& fileName)
+{
+	ifstream infile (fileName.c_str());
+	if (!infile)
+		return false;
+	string key;
+	while (infile >> key)
+	{
+		if (key == "insertion_cutoff")
+			infile >> insertionCutoff;
+		else if (key == "merge_block")
+			infile >> mergeBlock;
+		else if (key == "engine")
+		{
+			int s, o, r, e;
+			infile >> s >> o >> r >> e;
+			if (s >= 0 && s < SIZE_CLASSES && o >= RANDOM && o <= REVERSE_ORDER &&
+				r >= NARROW && r <= WIDE && e >= SELECTION && e < AUTO && (s == 0 || bounded (e)))
+				engine[s][o][r] = e;
+		}
+		else	// comment or unknown key: skip the rest of the line
+			getline (infile, key);
+	}	// end while
+	if (insertionCutoff < 1)
+		insertionCutoff = 1;
+	if (mergeBlock < 1)
+		mergeBlock = 1;
+	return true;
+}	// end method
+
+/**
+ * @brief       save() writes the profile as one setting per line.
+ *
+ * @param        fileName     	the name of the profile file
+ *
+ * @return  	true if the file could be written
+**/
+bool Profile::save (const string& fileName) const
+{
+	ofstream outfile (fileName.c_str());
+	if (!outfile)
+		return false;
+	outfile << "# sort profile: engine <size class> <order> <key range> <sort>\n";
+	outfile << "insertion_cutoff " << insertionCutoff << '\n';
+	outfile << "merge_block " << mergeBlock << '\n';
+	for (int s = 0; s < SIZE_CLASSES; s++)
+		for (int o = RANDOM; o <= REVERSE_ORDER; o++)
+			for (int r = NARROW; r <= WIDE; r++)
+				outfile << "engine " << s << ' ' << o << ' ' << r << ' ' << engine[s][o][r] << '\n';
+	return outfile.good();
+}	// end method
+
+/**
+ * @brief       tune() measures this machine. The hybrid cutoffs are swept first,
+ *				then every engine is timed on a representative array of each class
+ *				and the fastest one is kept. An engine is not tried at the next size
+ *				once its time, grown as much as over the last decade, would pass one second.
+ *				Above the smallest class only bounded() engines are tried: a class
+ *				also holds inputs far less friendly than the one array it is timed on.
+ *
+ * @param[out]   outfile    	stream out for the progress report
+**/
+void Profile::tune (ostream& outfile)
+{
+	const int CUTOFFS = 8;
+	int cutoffs[CUTOFFS] = {4, 8, 12, 16, 24, 32, 48, 64};
+	const double SLOW = 1.0;	// seconds
+
+	insertionCutoff = tuneCutoff (HYBRIDQUICK, cutoffs, CUTOFFS, outfile);
+	mergeBlock = tuneCutoff (HYBRIDMERGE, cutoffs, CUTOFFS, outfile);
+
+	outfile << '\n' << setw(9) << "Size" << setw(10) << "Order" << setw(10) << "Range"
+			<< setw(16) << "Engine" << setw(14) << "Time\n";
+	for (int i = 0; i < 59; ++i)
+		outfile << '-';
+	outfile << endl;
+
+	for (int o = RANDOM; o <= REVERSE_ORDER; o++)
+		for (int r = NARROW; r <= WIDE; r++)
+		{
+			double last[AUTO];		// time of each engine at the previous size (-1 = dropped)
+			double growth[AUTO];	// time ratio of each engine over the previous decade
+			for (int e = SELECTION; e < AUTO; e++)
+			{
+				last[e] = 0;
+				growth[e] = 100;
+			}	// end for
+			for (int s = 0; s < SIZE_CLASSES; s++)
+			{
+				int size = SIZE_CLASS_LIMITS[s];
+				int keyRange = (r == NARROW) ? (size/16 > 2 ? size/16 : 2) : size*4;
+				Array numbers (size, o, keyRange);
+				int best = engine[s][o][r];
+				double bestTime = -1;
+				for (int e = SELECTION; e < AUTO; e++)
+				{
+					if (s > 0 && !bounded (e))
+						continue;
+					if (last[e] < 0 || last[e] * growth[e] > SLOW)	// too slow at this size
+					{
+						last[e] = -1;
+						continue;
+					}	// end if
+					double time = timeSort (numbers, e, getCutoff (e));
+					// the growth seen over this decade, between linear and quadratic
+					growth[e] = (last[e] > 0) ? time / last[e] : 100;
+					if (growth[e] < 10)
+						growth[e] = 10;
+					else if (growth[e] > 100)
+						growth[e] = 100;
+					last[e] = time;
+					if (bestTime < 0 || time < bestTime)
+					{
+						bestTime = time;
+						best = e;
+					}	// end if
+				}	// end for engines
+				if (bestTime < 0 && s > 0)	// every engine dropped: keep the smaller class' choice
+					best = bounded (engine[s-1][o][r]) ? engine[s-1][o][r] : HYBRIDMERGE;
+				engine[s][o][r] = best;
+				outfile << setw(9) << size << setw(10) << ORDER_NAMES[o] << setw(10) << RANGE_NAMES[r]
+						<< setw(16) << SORT_NAMES[best];
+				if (bestTime < 0)
+					outfile << setw(13) << "-" << endl;
+				else
+					outfile << setw(13) << setprecision(6) << setiosflags (ios::showpoint|ios::fixed)
+							<< bestTime << endl;
+			}	// end for sizes
+		}	// end for ranges
+}	// end method
+
+/**
+ * @brief       choose() returns the tuned engine for the class of numbers.
+ *
+ * @param        numbers     	the array about to be sorted
+**/
+int Profile::choose (const Array& numbers) const
+{
+	return engine[sizeClass (numbers.getSize())][orderClass (numbers)][rangeClass (numbers)];
+}	// end method
+
+/**
+ * @brief       getInsertionCutoff () returns the cutoff for hybridQuickSort()
+**/
+int Profile::getInsertionCutoff () const
+{
+	return insertionCutoff;
+}	// end method
+
+/**
+ * @brief       getMergeBlock () returns the block size for hybridMergeSort()
+**/
+int Profile::getMergeBlock () const
+{
+	return mergeBlock;
+}	// end method
+
+/**
+ * @brief       getCutoff () returns the cutoff Array::sortBy() needs for sortType:
+ *				the merge block for hybridMergeSort(), the insertion cutoff otherwise
+ *
+ * @param        sortType    	the enum which evokes the type of sort method
+**/
+int Profile::getCutoff (int sortType) const
+{
+	return (sortType == HYBRIDMERGE) ? mergeBlock : insertionCutoff;
+}	// end method
+
+/**
+ * @brief       bounded() tells whether a sort is O(n log n) even in its worst case.
+ *				The quick sorts are not: Lomuto partitioning is quadratic on runs of
+ *				equal keys, and plain quick sort on ordered data.
+ *
+ * @param        sortType    	the enum which evokes the type of sort method
+**/
+bool Profile::bounded (int sortType)
+{
+	return sortType == MERGE || sortType == HEAP || sortType == HYBRIDMERGE;
+}	// end method
+
+/**
+ * @brief       sizeClass() maps a size onto its decade.
+ *
+ * @param        size     	the number of elements
+**/
+int Profile::sizeClass (int size)
+{
+	int s = 0;
+	while (s < SIZE_CLASSES - 1 && size > SIZE_CLASS_LIMITS[s])
+		s++;
+	return s;
+}	// end method
+
+/**
+ * @brief       orderClass() looks at every adjacent pair: data with at least 90%
+ *				rising (falling) pairs is treated as in order (reverse order).
+ *				Equal pairs do not count either way.
+ *
+ * @param        numbers     	the array to be classified
+**/
+int Profile::orderClass (const Array& numbers)
+{
+	int rising = 0, falling = 0;
+	for (int i = 0; i + 1 < numbers.getSize(); i++)
+	{
+		int a = numbers.getValue (i), b = numbers.getValue (i+1);
+		if (a < b)
+			rising++;
+		else if (a > b)
+			falling++;
+	}	// end for
+	if (falling * 9 <= rising)
+		return IN_ORDER;
+	if (rising * 9 <= falling)
+		return REVERSE_ORDER;
+	return RANDOM;
+}	// end method
+
+/**
+ * @brief       rangeClass() compares the spread of the keys with the size.
+ *
+ * @param        numbers     	the array to be classified
+**/
+int Profile::rangeClass (const Array& numbers)
+{
+	if (numbers.getSize() == 0)
+		return WIDE;
+	int smallest = numbers.getValue (0), largest = smallest;
+	for (int i = 1; i < numbers.getSize(); i++)
+	{
+		int value = numbers.getValue (i);
+		if (value < smallest)
+			smallest = value;
+		else if (value > largest)
+			largest = value;
+	}	// end for
+	return ((long long) largest - smallest + 1 < numbers.getSize() / 2) ? NARROW : WIDE;
+}	// end method
+
+/**
+ * @brief       timeSort() sorts copies of numbers until about 0.2 million elements
+ *				have been sorted (or 0.05 seconds spent) and returns the average
+ *				time per sort.
+ *
+ * @param        numbers     	the array to be sorted (left unchanged)
+ * @param        sortType    	the enum which evokes the type of sort method
+ * @param        cutoff    		the cutoff for the hybrid sorts
+**/
+double Profile::timeSort (const Array& numbers, int sortType, int cutoff) const
+{
+	const double ENOUGH = 0.05;	// seconds
+	int reps = 0;
+	long long sorted = 0;
+	double total = 0;
+	while (reps == 0 || (sorted < 200000 && total < ENOUGH))
+	{
+		reps++;
+		sorted += numbers.getSize() > 0 ? numbers.getSize() : 1;
+		Array copy (numbers);
+		total += copy.sortBy (sortType, cutoff).first;
+	}	// end while
+	return total / reps;
+}	// end method
+
+/**
+ * @brief       tuneCutoff() sweeps the candidate cutoffs of one hybrid sort on
+ *				random data of 100,000 distinct-ish keys and returns the fastest.
+ *
+ * @param        sortType    	HYBRIDQUICK or HYBRIDMERGE
+ * @param        candidates    	the cutoffs to be tried
+ * @param        count    		the number of candidates
+ * @param[out]   outfile    	stream out for the progress report
+**/
+int Profile::tuneCutoff (int sortType, const int* candidates, int count, ostream& outfile)
+{
+	const int SIZE = 100000;
+	Array numbers (SIZE, RANDOM, SIZE*4);
+	int best = candidates[0];
+	double bestTime = -1;
+	outfile << SORT_NAMES[sortType] << " cutoff:";
+	for (int i = 0; i < count; i++)
+	{
+		double time = 0;
+		for (int rep = 0; rep < 5; rep++)
+			time += timeSort (numbers, sortType, candidates[i]);
+		outfile << "  " << candidates[i] << '=' << setprecision(4) << setiosflags (ios::fixed) << time / 5;
+		if (bestTime < 0 || time < bestTime)
+		{
+			bestTime = time;
+			best = candidates[i];
+		}	// end if
+	}	// end for
+	outfile << "  -> " << best << endl;
+	return best;
+}	// end method
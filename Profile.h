@@ -0,0 +1,57 @@
+/**
+ * @file    Profile.h
+ * @brief   A tuning profile holds the hybrid cutoffs and the fastest sorting
+ *			engine for each class of input (size, presortedness, key range).
+ *			It is measured once per machine and saved to a text file, which
+ *			is loaded at startup by the AUTO sort.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "Array.h"
+#include <fstream>
+	using std::ifstream;
+	using std::ofstream;
+
+// Size classes are decades: up to 100, 1000, 10,000, 100,000 and beyond.
+const int SIZE_CLASSES = 5;
+const int SIZE_CLASS_LIMITS[SIZE_CLASSES] = {100, 1000, 10000, 100000, 1000000};
+// Key range classes: NARROW has fewer than size/2 distinct keys (many duplicates).
+enum RANGES {NARROW, WIDE};
+const int RANGE_CLASSES = 2;
+const string RANGE_NAMES[RANGE_CLASSES] = {"Narrow", "Wide  "};
+
+const string PROFILE_FILE = "profile.txt";
+
+class Profile
+{
+public:
+	Profile ();						// default (untuned) profile
+	bool load (const string& fileName);
+	bool save (const string& fileName) const;
+	void tune (ostream& outfile = cout);
+	int choose (const Array& numbers) const;
+	int getInsertionCutoff () const;
+	int getMergeBlock () const;
+	int getCutoff (int sortType) const;
+
+	static bool bounded (int sortType);
+	static int sizeClass (int size);
+	static int orderClass (const Array& numbers);
+	static int rangeClass (const Array& numbers);
+
+private:
+	double timeSort (const Array& numbers, int sortType, int cutoff) const;
+	int tuneCutoff (int sortType, const int* candidates, int count, ostream& outfile);
+
+private:
+	int insertionCutoff;
+	int mergeBlock;
+	int engine[SIZE_CLASSES][3][RANGE_CLASSES];
+};
+
+#endif
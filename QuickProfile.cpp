@@ -0,0 +1,168 @@
+/**
+ * @file    QuickProfile.cpp
+ * @brief   This file contains the implementation of the quick sort profile:
+ *			the per-depth counters, the report and the folded-stack export.
+ *			It is empty unless the program is built with -DQUICKSORT_PROFILE.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "QuickProfile.h"
+
+#ifdef QUICKSORT_PROFILE
+
+#include <iomanip>
+	using std::setw;
+	using std::setprecision;
+	using std::setiosflags;
+	using std::ios;
+	using std::endl;
+
+/**
+ * @brief       A new profile is empty.
+**/
+QuickProfile::QuickProfile ()
+{
+	reset();
+}	// end method
+
+/**
+ * @brief       reset() empties the profile before the next sort.
+**/
+void QuickProfile::reset ()
+{
+	calls.clear();
+	seconds.clear();
+	for (int b = 0; b < SPLIT_BUCKETS; b++)
+		histogram[b] = 0;
+	depthSum = 0;
+	callCount = 0;
+	maxDepth = 0;
+}	// end method
+
+/**
+ * @brief       call() records a recursive call at depth (1 for the outermost).
+ *
+ * @param        depth     		the recursion depth of the call
+**/
+void QuickProfile::call (int depth)
+{
+	if ((int) calls.size() <= depth)
+	{
+		calls.resize (depth + 1, 0);
+		seconds.resize (depth + 1, 0);
+	}	// end if
+	calls[depth]++;
+	depthSum += depth;
+	callCount++;
+	if (maxDepth < depth)
+		maxDepth = depth;
+}	// end method
+
+/**
+ * @brief       split() records one partition: the sizes of the parts on each side
+ *				of the pivot and the time since start.
+ *
+ * @param        depth     		the recursion depth of the partitioning call
+ * @param        left     		the elements left of the pivot
+ * @param        right     		the elements right of the pivot
+ * @param        start     		when the partition began
+**/
+void QuickProfile::split (int depth, int left, int right, std::chrono::steady_clock::time_point start)
+{
+	seconds[depth] += std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+	int bucket = (int) ((long long) left * SPLIT_BUCKETS / (left + right + 1));
+	histogram[bucket]++;
+}	// end method
+
+/**
+ * @brief       report() prints the call and depth summary, the split ratio
+ *				histogram and the calls and partition time by depth. Deep
+ *				recursions are shown in at most 32 bands of depths.
+ *
+ * @param[out]   outfile    	stream out
+**/
+void QuickProfile::report (ostream& outfile) const
+{
+	outfile << "Calls: " << callCount << "   Max depth: " << maxDepth << "   Average depth: "
+			<< setprecision(2) << setiosflags (ios::showpoint|ios::fixed)
+			<< (callCount > 0 ? (double) depthSum / callCount : 0) << endl;
+
+	long long partitions = 0;
+	for (int b = 0; b < SPLIT_BUCKETS; b++)
+		partitions += histogram[b];
+	outfile << "Split ratio (left part / partitioned elements):" << endl;
+	for (int b = 0; b < SPLIT_BUCKETS; b++)
+	{
+		outfile << "  " << setprecision(1) << b * 1.0 / SPLIT_BUCKETS << '-'
+				<< (b + 1) * 1.0 / SPLIT_BUCKETS << setw(12) << histogram[b] << "  ";
+		int bar = (partitions > 0) ? (int) (histogram[b] * 50 / partitions) : 0;
+		for (int i = 0; i < bar; i++)
+			outfile << '#';
+		outfile << endl;
+	}	// end for
+
+	int band = (maxDepth + 31) / 32;
+	if (band < 1)
+		band = 1;
+	outfile << setw(16) << "Depth" << setw(14) << "Calls" << setw(14) << "Seconds" << endl;
+	for (int first = 1; first <= maxDepth; first += band)
+	{
+		int last = (first + band - 1 < maxDepth) ? first + band - 1 : maxDepth;
+		long long bandCalls = 0;
+		double bandSeconds = 0;
+		for (int d = first; d <= last; d++)
+		{
+			bandCalls += calls[d];
+			bandSeconds += seconds[d];
+		}	// end for
+		outfile << setw(8) << first << " - " << setw(5) << last << setw(14) << bandCalls
+				<< setw(14) << setprecision(6) << bandSeconds << endl;
+	}	// end for bands
+}	// end method
+
+/**
+ * @brief       writeFolded() writes the partition time as folded stacks, one line
+ *				per depth: "root;frame;frame;... microseconds". The lines can be
+ *				fed to flamegraph.pl as they are. Recursions deeper than 256 levels
+ *				(the plain quick sort on ordered data) are folded into 256 frames,
+ *				each named "frame*levels".
+ *
+ * @param[out]   outfile    	stream out
+ * @param        root     		the first frame, e.g. the sort and order
+ * @param        frame     		the name of the recursive method
+**/
+void QuickProfile::writeFolded (ostream& outfile, const string& root, const string& frame) const
+{
+	const int MAX_FRAMES = 256;
+	int band = (maxDepth + MAX_FRAMES - 1) / MAX_FRAMES;
+	if (band < 1)
+		band = 1;
+	string name = frame;
+	if (band > 1)
+		name += '*' + std::to_string (band);
+	string stack = root;
+	for (int first = 1; first <= maxDepth; first += band)
+	{
+		stack += ';';
+		stack += name;
+		double bandSeconds = 0;
+		for (int d = first; d < first + band && d <= maxDepth; d++)
+			bandSeconds += seconds[d];
+		long long micros = (long long) (bandSeconds * 1e6 + 0.5);
+		if (micros > 0)
+			outfile << stack << ' ' << micros << '\n';
+	}	// end for
+}	// end method
+
+/**
+ * @brief       current() returns the profile of the calling thread.
+**/
+QuickProfile& QuickProfile::current ()
+{
+	thread_local QuickProfile profile;
+	return profile;
+}	// end method
+
+#endif
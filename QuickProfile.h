@@ -0,0 +1,58 @@
+/**
+ * @file    QuickProfile.h
+ * @brief   Optional tracing of the recursive quick sorts. When the program is
+ *			built with -DQUICKSORT_PROFILE every call and every partition of
+ *			quickSort(int,int) and randomizedQuickSort(int,int) is recorded: the
+ *			split ratio, the recursion depth, and the time spent partitioning
+ *			at each depth. Without the flag QS_PROFILE() expands to nothing,
+ *			so the sorts compile exactly as before.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef QUICKPROFILE_H
+#define QUICKPROFILE_H
+
+#ifdef QUICKSORT_PROFILE
+
+#include <chrono>
+#include <iostream>
+	using std::ostream;
+#include <string>
+	using std::string;
+#include <vector>
+	using std::vector;
+
+#define QS_PROFILE(...) __VA_ARGS__
+
+const int SPLIT_BUCKETS = 10;
+
+class QuickProfile
+{
+public:
+	QuickProfile ();
+	void reset ();
+	void call (int depth);
+	void split (int depth, int left, int right, std::chrono::steady_clock::time_point start);
+	void report (ostream& outfile) const;
+	void writeFolded (ostream& outfile, const string& root, const string& frame) const;
+
+	static QuickProfile& current ();	// the profile of the calling thread
+
+private:
+	vector<long long> calls;		// calls[d]: recursive calls at depth d
+	vector<double> seconds;			// seconds[d]: partition time at depth d
+	long long histogram[SPLIT_BUCKETS];	// left part / partitioned elements
+	long long depthSum;
+	long long callCount;
+	int maxDepth;
+};
+
+#else
+
+#define QS_PROFILE(...)
+
+#endif
+
+#endif
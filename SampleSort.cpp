@@ -0,0 +1,317 @@
+/**
+ * @file    SampleSort.cpp
+ * @brief   This file contains the implementation of the multi-process sample
+ *			sort: splitter selection, the shared segment and the worker steps.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "SampleSort.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+	using std::setw;
+	using std::setprecision;
+	using std::setiosflags;
+	using std::ios;
+#include <vector>
+	using std::vector;
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Everything the workers share, laid out in one anonymous shared mapping.
+namespace
+{
+	const size_t ALIGN = 64;	// keep every part on its own cache lines
+
+	size_t align (size_t bytes)
+	{
+		return (bytes + ALIGN - 1) / ALIGN * ALIGN;
+	}
+
+	struct Segment
+	{
+		pthread_barrier_t* barrier;
+		int* splitters;			// workers - 1 values
+		int* counts;			// counts[w * workers + b]: values of slice w in bucket b
+		WorkerStats* stats;		// one per worker
+		int* input;				// size values, the unsorted copy
+		int* output;			// size values, bucket after bucket
+		void* base;
+		size_t bytes;
+	};
+}
+
+/**
+ * @brief       The constructor records how the sort is to be run.
+ *
+ * @param        workers     		the number of worker processes (and buckets)
+ * @param        sortType     		the Array engine each worker uses on its bucket
+ * @param        cutoff     		the cutoff for the hybrid engines
+ * @param        oversampling     	samples taken per splitter
+**/
+SampleSort::SampleSort (int workers, int sortType, int cutoff, int oversampling)
+{
+	this->workers = (workers > 0) ? workers : 1;
+	this->sortType = sortType;
+	this->cutoff = cutoff;
+	this->oversampling = (oversampling > 0) ? oversampling : 1;
+	size = 0;
+	stats = new WorkerStats [this->workers];
+	for (int w = 0; w < this->workers; w++)
+	{
+		WorkerStats empty = {0, 0, 0, 0};
+		stats[w] = empty;
+	}	// end for
+}	// end method
+
+/**
+ * @brief       Destructor will free the worker statistics
+**/
+SampleSort::~SampleSort ()
+{
+	delete [] stats;
+}	// end method
+
+/**
+ * @brief       sort() sorts numbers with the worker processes and copies the result
+ *				back into it. Each worker does three steps, separated by a
+ *				process-shared barrier:
+ *				1. count how many values of its slice of the input go to each bucket;
+ *				2. work out where its share of every bucket starts and scatter its slice;
+ *				3. sort its own bucket with the chosen engine.
+ *
+ * @param[out]   numbers     	the array to be sorted
+ *
+ * @return  	the wall time (-1 when the processes could not be started) and the
+ *				total comparisons
+**/
+pair<double,int> SampleSort::sort (Array& numbers)
+{
+	pair<double,int> record (-1.0, 0);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size = numbers.getSize();
+
+	vector<int> splitters (workers);
+	int comparision_count = chooseSplitters (numbers, &splitters[0]);
+
+	Segment segment;
+	size_t offsets[6];
+	offsets[0] = 0;
+	offsets[1] = offsets[0] + align (sizeof (pthread_barrier_t));
+	offsets[2] = offsets[1] + align (sizeof (int) * workers);
+	offsets[3] = offsets[2] + align (sizeof (int) * workers * workers);
+	offsets[4] = offsets[3] + align (sizeof (WorkerStats) * workers);
+	offsets[5] = offsets[4] + align (sizeof (int) * size);
+	segment.bytes = offsets[5] + align (sizeof (int) * size);
+	segment.base = mmap (NULL, segment.bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (segment.base == MAP_FAILED)
+	{
+		perror ("mmap");
+		return record;
+	}	// end if
+	char* base = (char*) segment.base;
+	segment.barrier = (pthread_barrier_t*) (base + offsets[0]);
+	segment.splitters = (int*) (base + offsets[1]);
+	segment.counts = (int*) (base + offsets[2]);
+	segment.stats = (WorkerStats*) (base + offsets[3]);
+	segment.input = (int*) (base + offsets[4]);
+	segment.output = (int*) (base + offsets[5]);
+
+	for (int i = 0; i < workers - 1; i++)
+		segment.splitters[i] = splitters[i];
+	numbers.copyTo (segment.input);
+
+	pthread_barrierattr_t attr;
+	pthread_barrierattr_init (&attr);
+	pthread_barrierattr_setpshared (&attr, PTHREAD_PROCESS_SHARED);
+	pthread_barrier_init (segment.barrier, &attr, workers);
+	pthread_barrierattr_destroy (&attr);
+
+	vector<pid_t> children;
+	bool failed = false;
+	for (int w = 0; w < workers && !failed; w++)
+	{
+		pid_t pid = fork();
+		if (pid < 0)
+		{
+			perror ("fork");
+			failed = true;
+		}
+		else if (pid == 0)	// worker w
+		{
+			clock_t begin = clock();
+			int first = (int) ((long long) size * w / workers);
+			int last = (int) ((long long) size * (w+1) / workers);
+			int* myCounts = &segment.counts[w * workers];
+			int comparisons = 0;
+			vector<int> buckets (last - first);
+			for (int b = 0; b < workers; b++)
+				myCounts[b] = 0;
+			for (int i = first; i < last; i++)
+			{
+				buckets[i - first] = bucketOf (segment.input[i], segment.splitters, workers - 1, comparisons);
+				myCounts[buckets[i - first]]++;
+			}	// end for
+			double partitionTime = (clock() - begin) * 1.0 / CLOCKS_PER_SEC;
+
+			pthread_barrier_wait (segment.barrier);	// all counts are in
+
+			begin = clock();
+			vector<int> next (workers);	// where this slice's share of each bucket goes
+			int bucketStart = 0, position = 0;
+			for (int b = 0; b < workers; b++)
+			{
+				if (b == w)
+					bucketStart = position;
+				for (int v = 0; v < workers; v++)
+				{
+					if (v == w)
+						next[b] = position;
+					position += segment.counts[v * workers + b];
+				}	// end for slices
+			}	// end for buckets
+			for (int i = first; i < last; i++)
+				segment.output[next[buckets[i - first]]++] = segment.input[i];
+			partitionTime += (clock() - begin) * 1.0 / CLOCKS_PER_SEC;
+
+			pthread_barrier_wait (segment.barrier);	// all buckets are filled
+
+			int bucketSize = 0;
+			for (int v = 0; v < workers; v++)
+				bucketSize += segment.counts[v * workers + w];
+			Array bucket (&segment.output[bucketStart], bucketSize, BORROWED);	// sorted in place
+			pair<double,int> sorted = bucket.sortBy (sortType, cutoff);
+
+			WorkerStats mine = {bucketSize, comparisons + sorted.second, partitionTime, sorted.first};
+			segment.stats[w] = mine;
+			_exit (0);
+		}
+		else
+			children.push_back (pid);
+	}	// end for workers
+
+	// Reap the workers in the order they exit. Once one has failed or died (fork
+	// failure, OOM, a signal) the rest would wait at a barrier forever, so kill them.
+	if (failed)
+		for (int i = 0; i < (int) children.size(); i++)
+			kill (children[i], SIGKILL);
+	while (!children.empty())
+	{
+		int status;
+		pid_t pid = waitpid (-1, &status, 0);
+		if (pid < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			perror ("waitpid");
+			failed = true;
+			break;
+		}	// end if
+		vector<pid_t>::iterator worker = std::find (children.begin(), children.end(), pid);
+		if (worker == children.end())
+			continue;	// not a worker of this sort
+		children.erase (worker);
+		if ((!WIFEXITED (status) || WEXITSTATUS (status) != 0) && !failed)
+		{
+			failed = true;
+			for (int i = 0; i < (int) children.size(); i++)
+				kill (children[i], SIGKILL);
+		}	// end if
+	}	// end while
+
+	if (!failed)
+	{
+		numbers.copyFrom (segment.output);
+		for (int w = 0; w < workers; w++)
+		{
+			stats[w] = segment.stats[w];
+			comparision_count += stats[w].comparisons;
+		}	// end for
+		record.first = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+		record.second = comparision_count;
+	}	// end if
+	pthread_barrier_destroy (segment.barrier);
+	munmap (segment.base, segment.bytes);
+	return record;
+}	// end method
+
+/**
+ * @brief       report() prints each worker's bucket, its load relative to an even
+ *				split, and its partition and sort times.
+ *
+ * @param[out]   outfile    	stream out
+**/
+void SampleSort::report (ostream& outfile) const
+{
+	double even = (double) size / workers;
+	double worst = 0;
+	outfile << setw(8) << "Worker" << setw(12) << "Bucket" << setw(12) << "Load"
+			<< setw(16) << "Partition" << setw(16) << "Sort\n";
+	for (int w = 0; w < workers; w++)
+	{
+		double load = (even > 0) ? stats[w].bucketSize / even : 0;
+		if (worst < load)
+			worst = load;
+		outfile << setw(8) << w << setw(12) << stats[w].bucketSize
+				<< setw(12) << setprecision(3) << setiosflags (ios::showpoint|ios::fixed) << load
+				<< setw(16) << setprecision(6) << stats[w].partitionTime
+				<< setw(15) << stats[w].sortTime << endl;
+	}	// end for
+	outfile << "Load imbalance (largest bucket / even share): "
+			<< setprecision(3) << worst << endl;
+}	// end method
+
+/**
+ * @brief       chooseSplitters() takes oversampling random values per worker, sorts
+ *				them and keeps every oversampling-th one as a splitter.
+ *
+ * @param        numbers     	the array to be sorted
+ * @param[out]   splitters     	room for workers - 1 splitters
+ *
+ * @return  	the comparisons spent sorting the sample
+**/
+int SampleSort::chooseSplitters (const Array& numbers, int* splitters)
+{
+	if (workers < 2 || numbers.getSize() == 0)
+		return 0;
+	int count = workers * oversampling;
+	vector<int> values (count);
+	for (int i = 0; i < count; i++)
+		values[i] = numbers.getValue (rand() % numbers.getSize());
+	Array sample (&values[0], count);
+	int comparision_count = sample.mergeSort().second;
+	for (int i = 0; i < workers - 1; i++)
+		splitters[i] = sample.getValue ((i+1) * oversampling);
+	return comparision_count;
+}	// end method
+
+/**
+ * @brief       bucketOf() binary searches the splitters: bucket b holds the values
+ *				from splitters[b-1] up to (not including) splitters[b].
+ *
+ * @param        value     				the value to be placed
+ * @param        splitters     			the sorted splitters
+ * @param        count     				the number of splitters
+ * @param[out]   comparision_count     	incremented once per comparison
+**/
+int SampleSort::bucketOf (int value, const int* splitters, int count, int& comparision_count)
+{
+	int first = 0, last = count;
+	while (first < last)
+	{
+		int mid = (first + last) / 2;
+		comparision_count++;
+		if (splitters[mid] <= value)
+			first = mid + 1;
+		else
+			last = mid;
+	}	// end while
+	return first;
+}	// end method
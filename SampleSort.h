@@ -0,0 +1,50 @@
+/**
+ * @file    SampleSort.h
+ * @brief   Sample sort spread over worker processes. Splitters are picked from
+ *			an oversampled set of values, every worker partitions its slice of
+ *			the input into buckets in a shared-memory segment, and then sorts one
+ *			bucket with one of the Array engines. The buckets end up side by side,
+ *			so no final merge is needed. The shared segment stands in for the
+ *			network of a multi-node setup.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef SAMPLESORT_H
+#define SAMPLESORT_H
+
+#include "Array.h"
+
+// What each worker reports back through the shared segment.
+struct WorkerStats
+{
+	int bucketSize;			// values in the bucket this worker sorted
+	int comparisons;		// partition and sort comparisons
+	double partitionTime;	// seconds counting and scattering its slice
+	double sortTime;		// seconds sorting its bucket
+};
+
+class SampleSort
+{
+public:
+	SampleSort (int workers, int sortType, int cutoff, int oversampling = 32);
+	~SampleSort ();
+	pair<double,int> sort (Array& numbers);
+	void report (ostream& outfile = cout) const;
+
+private:
+	SampleSort (const SampleSort&);	// not copyable
+	int chooseSplitters (const Array& numbers, int* splitters);
+	static int bucketOf (int value, const int* splitters, int count, int& comparision_count);
+
+private:
+	int workers;
+	int sortType;
+	int cutoff;
+	int oversampling;
+	int size;				// the size of the last sort
+	WorkerStats* stats;		// one per worker, valid after sort()
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file    Scheduler.cpp
+ * @brief   This file contains the implementation of the benchmark scheduler:
+ *			core discovery, cell ordering and the pinned worker threads.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "Scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief       The scheduler keeps at most one worker on each physical core, so
+ *				a concurrency limit above the core count is lowered to it.
+ *
+ * @param        concurrency     	the most cells run at once; 0 means no limit
+**/
+Scheduler::Scheduler (int concurrency)
+{
+	cpus = physicalCores();
+	if (concurrency > 0 && concurrency < (int) cpus.size())
+		cpus.resize (concurrency);
+}	// end method
+
+/**
+ * @brief       getConcurrency () will return the number of worker threads
+**/
+int Scheduler::getConcurrency () const
+{
+	return (int) cpus.size();
+}	// end method
+
+/**
+ * @brief       run() measures every cell. Each cell sorts its own copy of
+ *				arrays[orderType] (sortFunction takes the array by value), so
+ *				the cells share nothing but the read-only originals.
+ *
+ * @param        arrays     		the original arrays, indexed by order
+ * @param[out]   cells     		the cells to measure; records are filled in
+ * @param        sortFunction     the sort-selection function
+**/
+void Scheduler::run (Array* const arrays[], vector<Cell>& cells, SortFunction sortFunction) const
+{
+	// longest expected first
+	vector<int> queue (cells.size());
+	for (int i = 0; i < (int) cells.size(); i++)
+		queue[i] = i;
+	int size = cells.empty() ? 0 : arrays[cells[0].orderType]->getSize();
+	std::stable_sort (queue.begin(), queue.end(), [&] (int a, int b)
+	{
+		return expectedCost (cells[a].sortType, cells[a].orderType, size) >
+			   expectedCost (cells[b].sortType, cells[b].orderType, size);
+	});
+
+	std::atomic<int> next (0);
+	vector<std::thread> workers;
+	for (int w = 0; w < (int) cpus.size(); w++)
+	{
+		int cpu = cpus[w];
+		workers.push_back (std::thread ([&, cpu] ()
+		{
+#ifdef __linux__
+			cpu_set_t set;
+			CPU_ZERO (&set);
+			CPU_SET (cpu, &set);
+			sched_setaffinity (0, sizeof (set), &set);	// 0 = the calling thread
+#endif
+			for (int i = next++; i < (int) queue.size(); i = next++)
+			{
+				Cell& cell = cells[queue[i]];
+				cell.record = sortFunction (*arrays[cell.orderType], cell.sortType);
+			}	// end for
+		}));
+	}	// end for workers
+	for (int w = 0; w < (int) workers.size(); w++)
+		workers[w].join();
+}	// end method
+
+/**
+ * @brief       expectedCost() is the textbook operation count of a cell; only
+ *				its ranking matters. Bubble and insertion sort are linear on
+ *				in-order data, the plain quick sort is quadratic on ordered data.
+ *
+ * @param        sortType    	the enum which evokes the type of sort method
+ * @param        orderType   	the enum which evokes the type of order
+ * @param        size   		the number of elements
+**/
+double Scheduler::expectedCost (int sortType, int orderType, int size)
+{
+	double n = size;
+	double nlogn = n * log2 (n > 2 ? n : 2);
+	switch (sortType)
+	{
+		case SELECTION:
+			return n * n;
+		case BUBBLE:
+		case INSERTION:
+			return (orderType == IN_ORDER) ? n : n * n;
+		case MODINSERTION:		// the comparisons are n log n, the moves are not
+		case BININSERTION:
+			return (orderType == IN_ORDER) ? nlogn : n * n;
+		case BLOCKINSERTION:	// sqrt(n) moves per insert
+			return (orderType == IN_ORDER) ? nlogn : n * sqrt (n);
+		case QUICK:
+			return (orderType == RANDOM) ? nlogn : n * n;
+		default:
+			return nlogn;
+	} // end switch
+}	// end method
+
+/**
+ * @brief       physicalCores() lists the cpus this process may run on, keeping
+ *				only the first hyperthread of each core so that two busy cells
+ *				never share one.
+**/
+vector<int> Scheduler::physicalCores ()
+{
+	vector<int> result;
+#ifdef __linux__
+	cpu_set_t allowed;
+	CPU_ZERO (&allowed);
+	if (sched_getaffinity (0, sizeof (allowed), &allowed) == 0)
+	{
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if (!CPU_ISSET (cpu, &allowed))
+				continue;
+			// the sibling list starts with the lowest cpu of the core, e.g. "0,4" or "0-1"
+			char path[96];
+			snprintf (path, sizeof (path),
+					  "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+			int first = cpu;
+			FILE* file = fopen (path, "r");
+			if (file)
+			{
+				if (fscanf (file, "%d", &first) != 1)
+					first = cpu;
+				fclose (file);
+			}	// end if
+			// keep cpu unless an allowed sibling comes before it
+			if (first == cpu || !CPU_ISSET (first, &allowed))
+				result.push_back (cpu);
+		}	// end for
+	}	// end if
+#endif
+	if (result.empty())	// no affinity information: one worker per hardware thread
+	{
+		int count = (int) std::thread::hardware_concurrency();
+		for (int cpu = 0; cpu < (count > 0 ? count : 1); cpu++)
+			result.push_back (cpu);
+	}	// end if
+	return result;
+}	// end method
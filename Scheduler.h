@@ -0,0 +1,46 @@
+/**
+ * @file    Scheduler.h
+ * @brief   The benchmark scheduler runs the independent (sort, order) cells of a
+ *			timing table concurrently, one worker thread per physical core. Each
+ *			worker is pinned to its core and the cells are handed out longest
+ *			expected first, so the slow O(n^2) cells start right away.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Array.h"
+#include <vector>
+	using std::vector;
+
+// One cell of the timing table: the inputs and the measured record.
+struct Cell
+{
+	int sortType;
+	int orderType;
+	pair<double,int> record;
+};
+
+// The sort-selection function of main.cpp.
+typedef pair<double,int> (*SortFunction) (Array numbers, int sortType);
+
+class Scheduler
+{
+public:
+	Scheduler (int concurrency);	// 0 = one worker per physical core
+	void run (Array* const arrays[], vector<Cell>& cells, SortFunction sortFunction) const;
+	int getConcurrency () const;
+
+	static double expectedCost (int sortType, int orderType, int size);
+
+private:
+	static vector<int> physicalCores ();
+
+private:
+	vector<int> cpus;	// the logical cpu each worker is pinned to
+};
+
+#endif
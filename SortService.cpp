@@ -0,0 +1,459 @@
+/**
+ * @file    SortService.cpp
+ * @brief   This file contains the implementation of the sort service (the
+ *			poll loop, the batching and the worker pool) and of its client.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "SortService.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+	using std::map;
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Seals the client puts on its buffer, so that it cannot be cut short under the service.
+const int BUFFER_SEALS = F_SEAL_SHRINK | F_SEAL_GROW;
+
+// One connected client and the buffer it shared.
+struct SortService::Connection
+{
+	int fd;
+	int* values;		// NULL until the hello message maps the buffer
+	int capacity;
+	std::atomic<bool> busy;	// a request is queued or being sorted; the next must wait for its reply
+
+	Connection (int fd) : fd (fd), values (NULL), capacity (0), busy (false)
+	{
+	}
+
+	~Connection ()
+	{
+		if (values)
+			munmap (values, capacity * sizeof (int));
+		close (fd);
+	}
+};
+
+/**
+ * @brief       fillAddress() puts a socket path into a Unix domain address.
+ *
+ * @param        path     		the socket path
+ * @param[out]   address     	the address to fill
+ *
+ * @return  	false if the path is too long
+**/
+static bool fillAddress (const string& path, sockaddr_un& address)
+{
+	memset (&address, 0, sizeof (address));
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof (address.sun_path))
+		return false;
+	strcpy (address.sun_path, path.c_str());
+	return true;
+}	// end function
+
+/**
+ * @brief       The constructor records the service settings; nothing runs until run().
+ *
+ * @param        path     			the socket path
+ * @param        profile     		the tuning profile used for AUTO and the hybrid cutoffs
+ * @param        workers     		the threads in the pool
+ * @param        maxBatch     		the most requests in one batch
+ * @param        maxWaitMicros     	how long the first request of a batch may wait for more
+**/
+SortService::SortService (const string& path, const Profile& profile, int workers, int maxBatch,
+						  int maxWaitMicros)
+	: path (path), profile (profile)
+{
+	this->workers = (workers > 0) ? workers : 1;
+	this->maxBatch = (maxBatch > 0) ? maxBatch : 1;
+	this->maxWaitMicros = (maxWaitMicros > 0) ? maxWaitMicros : 0;
+	stopping = false;
+	requests = 0;
+	batchCount = 0;
+}	// end method
+
+/**
+ * @brief       Destructor will stop the pool if run() did not get to it
+**/
+SortService::~SortService ()
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		stopping = true;
+	}
+	ready.notify_all();
+	for (int i = 0; i < (int) pool.size(); i++)
+		if (pool[i].joinable())
+			pool[i].join();
+}	// end method
+
+/**
+ * @brief       run() is the front end. One poll loop accepts clients, maps the
+ *				buffer of each new client, and collects requests. Only small
+ *				requests are batched; a larger one goes to the pool at once, so
+ *				big sorts run on all the pool threads instead of one after another.
+ *				A batch is handed to the pool when it is full, when no connected
+ *				client is left that could add to it, or when its first request has
+ *				waited maxWaitMicros. A request with a negative count ends the
+ *				loop; the requests already taken are still served.
+ *
+ * @return  	false if the socket could not be set up
+**/
+bool SortService::run ()
+{
+	sockaddr_un address;
+	int listenFd = socket (AF_UNIX, SOCK_SEQPACKET, 0);
+	if (listenFd < 0 || !fillAddress (path, address))
+	{
+		perror ("socket");
+		return false;
+	}	// end if
+	unlink (path.c_str());
+	if (bind (listenFd, (sockaddr*) &address, sizeof (address)) < 0 || listen (listenFd, 128) < 0)
+	{
+		perror ("bind");
+		close (listenFd);
+		return false;
+	}	// end if
+
+	for (int i = 0; i < workers; i++)
+		pool.push_back (std::thread (&SortService::work, this));
+
+	map<int, shared_ptr<Connection> > connections;
+	vector<Request> pending;
+	std::chrono::steady_clock::time_point firstPending;
+	bool stopRequested = false;
+	while (!stopRequested)
+	{
+		vector<pollfd> fds (1);
+		fds[0].fd = listenFd;
+		fds[0].events = POLLIN;
+		for (map<int, shared_ptr<Connection> >::iterator it = connections.begin(); it != connections.end(); ++it)
+		{
+			pollfd entry = {it->first, POLLIN, 0};
+			fds.push_back (entry);
+		}	// end for
+		timespec timeout = {0, 0};	// with nothing pending, wait forever
+		if (!pending.empty())
+		{
+			long long waited = std::chrono::duration_cast<std::chrono::microseconds>
+							   (std::chrono::steady_clock::now() - firstPending).count();
+			long long left = (maxWaitMicros > waited) ? maxWaitMicros - waited : 0;
+			timeout.tv_sec = left / 1000000;
+			timeout.tv_nsec = (left % 1000000) * 1000;
+		}	// end if
+		ppoll (&fds[0], fds.size(), pending.empty() ? NULL : &timeout, NULL);
+
+		if (fds[0].revents & POLLIN)
+		{
+			int fd = accept (listenFd, NULL, NULL);
+			if (fd >= 0)
+				connections[fd] = shared_ptr<Connection> (new Connection (fd));
+		}	// end if
+		for (int i = 1; i < (int) fds.size(); i++)
+		{
+			if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+				continue;
+			shared_ptr<Connection> connection = connections[fds[i].fd];
+			char message[sizeof (ServiceHello) > sizeof (ServiceRequest) ?
+						 sizeof (ServiceHello) : sizeof (ServiceRequest)];
+			iovec part = {message, sizeof (message)};
+			char control[CMSG_SPACE (sizeof (int))];
+			msghdr header;
+			memset (&header, 0, sizeof (header));
+			header.msg_iov = &part;
+			header.msg_iovlen = 1;
+			header.msg_control = control;
+			header.msg_controllen = sizeof (control);
+			ssize_t received = recvmsg (connection->fd, &header, 0);
+			if (received <= 0)	// the client has gone
+			{
+				connections.erase (fds[i].fd);
+				continue;
+			}	// end if
+			if (!connection->values)	// the hello message with the buffer
+			{
+				cmsghdr* item = CMSG_FIRSTHDR (&header);
+				if (received != sizeof (ServiceHello) || !item || item->cmsg_type != SCM_RIGHTS)
+				{
+					connections.erase (fds[i].fd);
+					continue;
+				}	// end if
+				int bufferFd;
+				memcpy (&bufferFd, CMSG_DATA (item), sizeof (int));
+				ServiceHello hello;
+				memcpy (&hello, message, sizeof (hello));
+				// A buffer smaller than claimed, or one the client could still shrink,
+				// would raise SIGBUS in the service when touched past its end.
+				struct stat info;
+				void* mapped = MAP_FAILED;
+				if (hello.capacity > 0 && fstat (bufferFd, &info) == 0 &&
+					(long long) sizeof (int) * hello.capacity <= (long long) info.st_size &&
+					(fcntl (bufferFd, F_GET_SEALS) & BUFFER_SEALS) == BUFFER_SEALS)
+					mapped = mmap (NULL, hello.capacity * sizeof (int), PROT_READ | PROT_WRITE,
+								   MAP_SHARED, bufferFd, 0);
+				close (bufferFd);
+				if (mapped == MAP_FAILED)
+				{
+					connections.erase (fds[i].fd);
+					continue;
+				}	// end if
+				connection->values = (int*) mapped;
+				connection->capacity = hello.capacity;
+				continue;
+			}	// end if hello
+			ServiceRequest request;
+			memcpy (&request, message, sizeof (request));
+			if (request.count < 0)
+			{
+				stopRequested = true;
+				continue;
+			}	// end if
+			// one request at a time per buffer: two workers must not sort it together
+			if (request.count > connection->capacity || request.sortType < SELECTION || request.sortType > AUTO ||
+				connection->busy)
+			{
+				ServiceReply reply = {1, 0, 0};
+				send (connection->fd, &reply, sizeof (reply), MSG_NOSIGNAL);
+				continue;
+			}	// end if
+			connection->busy = true;
+			Request entry = {connection, request.count, request.sortType};
+			if (request.count > SMALL_REQUEST)	// worth a pool thread of its own
+			{
+				vector<Request> single (1, entry);
+				submit (single);
+				continue;
+			}	// end if
+			if (pending.empty())
+				firstPending = std::chrono::steady_clock::now();
+			pending.push_back (entry);
+			if ((int) pending.size() >= maxBatch)
+				submit (pending);
+		}	// end for connections
+		if (!pending.empty())
+		{
+			// Waiting only helps while some client could still add a request; a
+			// connection is busy from its request until the reply.
+			bool idle = false;
+			for (map<int, shared_ptr<Connection> >::iterator it = connections.begin();
+				 it != connections.end() && !idle; ++it)
+				idle = it->second->values && !it->second->busy;
+			if (!idle || std::chrono::duration_cast<std::chrono::microseconds>
+						 (std::chrono::steady_clock::now() - firstPending).count() >= maxWaitMicros)
+				submit (pending);
+		}	// end if
+	}	// end while
+	submit (pending);
+
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		stopping = true;
+	}
+	ready.notify_all();
+	for (int i = 0; i < (int) pool.size(); i++)
+		pool[i].join();
+	pool.clear();
+	connections.clear();
+	close (listenFd);
+	unlink (path.c_str());
+	cout << "Service: " << requests << " requests in " << batchCount << " batches" << endl;
+	return true;
+}	// end method
+
+/**
+ * @brief       submit() queues the pending requests as one batch and empties them.
+ *
+ * @param[out]   batch     	the requests to be queued
+**/
+void SortService::submit (vector<Request>& batch)
+{
+	if (batch.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		batches.push_back (vector<Request>());
+		batches.back().swap (batch);
+		batchCount++;
+	}
+	ready.notify_one();
+}	// end method
+
+/**
+ * @brief       work() is the loop of each pool thread: take a batch, serve every
+ *				request in it, repeat until the service stops and the queue is empty.
+**/
+void SortService::work ()
+{
+	while (true)
+	{
+		vector<Request> batch;
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			while (batches.empty() && !stopping)
+				ready.wait (lock);
+			if (batches.empty())
+				return;
+			batch.swap (batches.front());
+			batches.pop_front();
+			requests += batch.size();
+		}
+		for (int i = 0; i < (int) batch.size(); i++)
+			process (batch[i]);
+	}	// end while
+}	// end method
+
+/**
+ * @brief       process() sorts one request's values in place in the client's
+ *				buffer, through an Array view, and replies. AUTO is resolved with
+ *				the profile. The connection takes requests again before the reply
+ *				goes out, so the client's next request is never refused as early.
+ *
+ * @param        request     	the request to be served
+**/
+void SortService::process (const Request& request)
+{
+	Array numbers (request.connection->values, request.count, BORROWED);
+	int engine = (request.sortType == AUTO) ? profile.choose (numbers) : request.sortType;
+	pair<double,int> record = numbers.sortBy (engine, profile.getCutoff (engine));
+	ServiceReply reply = {0, record.second, record.first};
+	request.connection->busy = false;
+	send (request.connection->fd, &reply, sizeof (reply), MSG_NOSIGNAL);
+}	// end method
+
+/**
+ * @brief       A client is not connected until connect() succeeds.
+**/
+SortClient::SortClient ()
+{
+	socketFd = -1;
+	values = NULL;
+	capacity = 0;
+}	// end method
+
+/**
+ * @brief       Destructor will unmap the buffer and close the connection
+**/
+SortClient::~SortClient ()
+{
+	if (values)
+		munmap (values, capacity * sizeof (int));
+	if (socketFd >= 0)
+		close (socketFd);
+}	// end method
+
+/**
+ * @brief       connect() creates the shared buffer, sealed at its size, connects
+ *				to the service and sends it the buffer's descriptor. On failure
+ *				nothing is left open, so connect() may simply be tried again.
+ *
+ * @param        path     		the socket path of the service
+ * @param        capacity     	the most values a request will hold
+ *
+ * @return  	true if the service accepted the buffer
+**/
+bool SortClient::connect (const string& path, int capacity)
+{
+	sockaddr_un address;
+	if (socketFd >= 0 || capacity <= 0 || !fillAddress (path, address))
+		return false;
+	int bufferFd = memfd_create ("sort-buffer", MFD_ALLOW_SEALING);
+	if (bufferFd < 0 || ftruncate (bufferFd, capacity * sizeof (int)) < 0 ||
+		fcntl (bufferFd, F_ADD_SEALS, BUFFER_SEALS) < 0)
+	{
+		if (bufferFd >= 0)
+			close (bufferFd);
+		return false;
+	}	// end if
+	void* mapped = mmap (NULL, capacity * sizeof (int), PROT_READ | PROT_WRITE, MAP_SHARED, bufferFd, 0);
+	socketFd = socket (AF_UNIX, SOCK_SEQPACKET, 0);
+	if (mapped == MAP_FAILED || socketFd < 0 ||
+		::connect (socketFd, (sockaddr*) &address, sizeof (address)) < 0)
+	{
+		if (mapped != MAP_FAILED)
+			munmap (mapped, capacity * sizeof (int));
+		if (socketFd >= 0)
+			close (socketFd);
+		socketFd = -1;
+		close (bufferFd);
+		return false;
+	}	// end if
+	values = (int*) mapped;
+	this->capacity = capacity;
+
+	ServiceHello hello = {capacity};
+	iovec part = {&hello, sizeof (hello)};
+	char control[CMSG_SPACE (sizeof (int))];
+	memset (control, 0, sizeof (control));
+	msghdr header;
+	memset (&header, 0, sizeof (header));
+	header.msg_iov = &part;
+	header.msg_iovlen = 1;
+	header.msg_control = control;
+	header.msg_controllen = sizeof (control);
+	cmsghdr* item = CMSG_FIRSTHDR (&header);
+	item->cmsg_level = SOL_SOCKET;
+	item->cmsg_type = SCM_RIGHTS;
+	item->cmsg_len = CMSG_LEN (sizeof (int));
+	memcpy (CMSG_DATA (item), &bufferFd, sizeof (int));
+	bool sent = sendmsg (socketFd, &header, MSG_NOSIGNAL) == sizeof (hello);
+	close (bufferFd);	// the service has its own copy now
+	if (!sent)
+	{
+		munmap (values, capacity * sizeof (int));
+		values = NULL;
+		this->capacity = 0;
+		close (socketFd);
+		socketFd = -1;
+	}	// end if
+	return sent;
+}	// end method
+
+/**
+ * @brief       buffer() is where the values to be sorted are written and where
+ *				the sorted values are read back.
+**/
+int* SortClient::buffer () const
+{
+	return values;
+}	// end method
+
+/**
+ * @brief       sort() asks the service to sort the first count values of the
+ *				buffer and waits for the reply.
+ *
+ * @param        count     		the number of values
+ * @param        sortType     	an enum SORTS value, AUTO included
+ * @param[out]   reply     		the service's reply
+ *
+ * @return  	true if the values are sorted
+**/
+bool SortClient::sort (int count, int sortType, ServiceReply& reply)
+{
+	ServiceRequest request = {count, sortType};
+	if (send (socketFd, &request, sizeof (request), MSG_NOSIGNAL) != sizeof (request))
+		return false;
+	if (recv (socketFd, &reply, sizeof (reply), 0) != sizeof (reply))
+		return false;
+	return reply.status == 0;
+}	// end method
+
+/**
+ * @brief       stopService() asks the service to finish its work and exit.
+**/
+bool SortClient::stopService ()
+{
+	ServiceRequest request = {-1, 0};
+	return send (socketFd, &request, sizeof (request), MSG_NOSIGNAL) == sizeof (request);
+}	// end method
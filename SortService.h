@@ -0,0 +1,107 @@
+/**
+ * @file    SortService.h
+ * @brief   A long-running sort service for many small producer processes. A
+ *			client connects over a Unix domain socket and hands the service a
+ *			shared-memory buffer once (as a sealed memfd descriptor). Each
+ *			request then only names how many values in the buffer to sort; the
+ *			service sorts them in the buffer itself and replies, so the values
+ *			are never copied. Small requests arriving close together are
+ *			coalesced into batches, and each batch is run by one thread of a
+ *			pool; larger requests go to the pool one by one.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef SORTSERVICE_H
+#define SORTSERVICE_H
+
+#include "Array.h"
+#include "Profile.h"
+#include <condition_variable>
+#include <deque>
+	using std::deque;
+#include <memory>
+	using std::shared_ptr;
+#include <mutex>
+#include <thread>
+#include <vector>
+	using std::vector;
+
+// Requests of more values are not batched: sorting them outweighs a pool hand-off.
+const int SMALL_REQUEST = 1024;
+
+// The messages on the socket (SOCK_SEQPACKET keeps each one whole).
+struct ServiceHello		// first message, carries the buffer's descriptor
+{
+	int capacity;		// values the buffer holds
+};
+struct ServiceRequest
+{
+	int count;			// values to sort from the start of the buffer; < 0 stops the service.
+						// A connection has one request at a time; another before the reply is refused.
+	int sortType;		// an enum SORTS value, AUTO included
+};
+struct ServiceReply
+{
+	int status;			// 0 on success
+	int comparisons;
+	double seconds;		// the sort's own time
+};
+
+class SortService
+{
+public:
+	SortService (const string& path, const Profile& profile, int workers, int maxBatch, int maxWaitMicros);
+	~SortService ();
+	bool run ();		// serves until a stop request; false if the socket failed
+
+private:
+	struct Connection;
+	struct Request
+	{
+		shared_ptr<Connection> connection;
+		int count;
+		int sortType;
+	};
+
+	SortService (const SortService&);	// not copyable
+	void submit (vector<Request>& batch);
+	void work ();
+	void process (const Request& request);
+
+private:
+	string path;
+	const Profile& profile;
+	int workers;
+	int maxBatch;
+	int maxWaitMicros;
+	vector<std::thread> pool;
+	deque< vector<Request> > batches;	// waiting for a worker
+	std::mutex mutex;
+	std::condition_variable ready;
+	bool stopping;
+	long long requests;					// served so far
+	long long batchCount;				// batches submitted so far
+};
+
+class SortClient
+{
+public:
+	SortClient ();
+	~SortClient ();
+	bool connect (const string& path, int capacity);
+	int* buffer () const;
+	bool sort (int count, int sortType, ServiceReply& reply);
+	bool stopService ();
+
+private:
+	SortClient (const SortClient&);	// not copyable
+
+private:
+	int socketFd;
+	int* values;
+	int capacity;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file    Verify.cpp
+ * @brief   This file contains the implementation of the verifier tally.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#include "Verify.h"
+#include <chrono>
+#include <iomanip>
+	using std::setprecision;
+	using std::setiosflags;
+	using std::ios;
+#include <sstream>
+
+/**
+ * @brief       The tally starts empty.
+**/
+Verifier::Verifier () : runs (0), failures (0), nanoseconds (0)
+{
+}	// end method
+
+/**
+ * @brief       before() hashes the input of a sort.
+ *
+ * @param        numbers     	the array about to be sorted
+ *
+ * @return  	the multiset hash to be passed to after()
+**/
+unsigned long long Verifier::before (const Array& numbers)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	unsigned long long hash = numbers.multisetHash();
+	nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>
+				   (std::chrono::steady_clock::now() - start).count();
+	return hash;
+}	// end method
+
+/**
+ * @brief       after() checks the output of a sort and counts the run.
+ *
+ * @param        numbers     	the sorted array
+ * @param        inputHash     	the hash before() returned for the input
+ *
+ * @return  	true if the output is ordered and holds the input's values
+**/
+bool Verifier::after (const Array& numbers, unsigned long long inputHash)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool correct = numbers.isSorted() && numbers.multisetHash() == inputHash;
+	nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>
+				   (std::chrono::steady_clock::now() - start).count();
+	runs++;
+	if (!correct)
+		failures++;
+	return correct;
+}	// end method
+
+/**
+ * @brief       selected() checks the output of a selection (nth element, partial
+ *				sort, quantiles) and counts the run: it must hold the input's values
+ *				and agree with a verified sorted copy at every selected rank.
+ *
+ * @param        numbers     	the array after the selection
+ * @param        inputHash     	the hash before() returned for the input
+ * @param        sorted     	the same values fully sorted
+ * @param        ranks     		the selected ranks; NULL for the first count ranks
+ * @param        count     		the number of selected ranks
+ *
+ * @return  	true if the selection is correct
+**/
+bool Verifier::selected (const Array& numbers, unsigned long long inputHash,
+						 const Array& sorted, const int* ranks, int count)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool correct = numbers.getSize() == sorted.getSize() && numbers.multisetHash() == inputHash;
+	for (int i = 0; i < count && correct; i++)
+	{
+		int rank = (ranks != NULL) ? ranks[i] : i;
+		correct = numbers.getValue (rank) == sorted.getValue (rank);
+	}	// end for
+	nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>
+				   (std::chrono::steady_clock::now() - start).count();
+	runs++;
+	if (!correct)
+		failures++;
+	return correct;
+}	// end method
+
+/**
+ * @brief       report() prints the tally on one line.
+ *
+ * @param[out]   outfile    	stream out
+**/
+void Verifier::report (ostream& outfile) const
+{
+	std::ostringstream seconds;		// formatted apart, so the caller's table format is kept
+	seconds << setprecision(3) << setiosflags (ios::showpoint|ios::fixed) << nanoseconds / 1e9;
+	outfile << "Verified " << runs << " sorts, " << failures << " failed, "
+			<< seconds.str() << " s spent verifying" << endl;
+}	// end method
+
+/**
+ * @brief       reset() empties the tally.
+**/
+void Verifier::reset ()
+{
+	runs = 0;
+	failures = 0;
+	nanoseconds = 0;
+}	// end method
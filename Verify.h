@@ -0,0 +1,37 @@
+/**
+ * @file    Verify.h
+ * @brief   The verifier checks every benchmarked sort outside its timed region:
+ *			the output must be in order and hold the same multiset of values as
+ *			the input; a selection must instead match a sorted copy at the ranks
+ *			it selected. It keeps a tally of runs, failures and the time spent
+ *			verifying, so that cost is reported apart from the sort times.
+ *
+ * @author  Pavan Kumar Reddy Sama
+ * @date    Mon, Oct 19, 2026
+ */
+
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include "Array.h"
+#include <atomic>
+
+class Verifier
+{
+public:
+	Verifier ();
+	unsigned long long before (const Array& numbers);
+	bool after (const Array& numbers, unsigned long long inputHash);
+	bool selected (const Array& numbers, unsigned long long inputHash,
+				   const Array& sorted, const int* ranks, int count);
+	void report (ostream& outfile = cout) const;
+	void reset ();
+
+private:
+	// atomic because the Scheduler verifies cells on several threads
+	std::atomic<long long> runs;
+	std::atomic<long long> failures;
+	std::atomic<long long> nanoseconds;
+};
+
+#endif
@@ -18,28 +18,53 @@
 **/
 
 #include "Array.h"
+#include "Complexity.h"
+#include "Memory.h"
+#include "Profile.h"
+#include "QuickProfile.h"
+#include "SampleSort.h"
+#include "SortService.h"
+#include "Scheduler.h"
+#include "Verify.h"
 #include <iomanip>
 	using std::setw;
 	using std::setprecision;
 	using std::setiosflags;
 	using std::ios;
+#include <chrono>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // sort-selection function prototype
 pair<double,int> sort (Array numbers, int sortType);
 void testing (Array numbers, int sortType, int orderType);
+void time_statistics (int concurrency);
+void selection_statistics();
+void incremental_statistics();
+void sample_sort_statistics (int workers);
+void memory_statistics();
+void quick_sort_profile();
+void sort_service_statistics();
+void insertion_statistics();
 void main_menu();
 void sort_menu();
 
+Profile profile;	// hybrid cutoffs and engine choices for AUTO
+Verifier verifier;	// checks every sort() outside its timed region
+
 int main()
 {
 	srand (17);	// random seed
+	profile.load (PROFILE_FILE);	// keep the defaults when this machine is not tuned
 	
 	main_menu();
 	
 	int choice;
 	cout << "Enter the choice: ";
 	cin >> choice;
-	while (choice < 1 || choice > 4)
+	while (choice < 1 || choice > 13)
 	{
 		cout << "Invalid input\n";
 		cout << "Enter the choice again: ";
@@ -48,65 +73,7 @@ int main()
 
 	if (choice == 1)
 	{
-		double epsilon = 0.0005;
-		int size = 100;			// starting size
-		int sizeLimit = 30000;	// size limit
-		int multiplier = 10;
-		double maxTime = 0;
-		double timeLimit = 60;
-		do
-		{
-			// Title of table
-			cout << setw(9) << size << setw(50) << "Random" << setw(20) << "Inorder" << setw(20) << "Reverse\n";
-			for (int i = 0; i < 100; ++i)
-				cout << '-';
-			cout << endl;
-
-			Array* a[3];	// allocate dynamic arrays
-			a[0] = new Array (size, RANDOM);
-			a[1] = new Array (size, IN_ORDER);
-			a[2] = new Array (size, REVERSE_ORDER);
-			// enum SORTS {SELECTION, BUBBLE, INSERTION, MODINSERTION, MERGE, QUICK, RANQUICK, HEAP};
-			for (int sortIndx = SELECTION; sortIndx <= HEAP; sortIndx++)
-			{
-				cout << SORT_NAMES[sortIndx] << setw(25) << "Time:              ";
-				// enum ORDERS {RANDOM, IN_ORDER, REVERSE_ORDER}
-				for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
-				{
-					// pair<double,int> record = sort(*a[orderIndx], sortIndx);
-					double time = sort(*a[orderIndx], sortIndx).first;
-					if (maxTime < time)
-						maxTime = time;
-					if (time > epsilon)
-						cout << setw(20) << setprecision(3) << setiosflags (ios::showpoint|ios::fixed)
-							 << time;
-					else	// avoid distracting display of decimals for very small times
-						cout << setw(20) << "0";
-				}	// end for orderIndx
-				cout << endl;
-				cout << "             " << setw(25) << "Comparision Count: ";
-				for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
-				{
-					int comparision_count = sort(*a[orderIndx], sortIndx).second;
-					cout << setw(20) << comparision_count;
-				}	// end for orderIndx
-				cout << endl;
-				for (int i = 0; i < 19; ++i)
-					cout << ' ';
-				for (int i = 0; i < 81; ++i)
-					cout << '-';
-				cout << endl;
-			}	// end for sortIndx
-			cout << endl;
-			// free dynamic arrays 
-			for (int i = 0; i < 3; i++)
-			{
-				delete a[i];
-			}	// end for loop of setting dynamic arrays free
-			size *= multiplier;
-			multiplier = (size==10000) ? 3 : 10;	// alternate multiplier
-		}	// end do while
-		while (maxTime < timeLimit && size <=sizeLimit);
+		time_statistics (1);
 	} // end choice == 1, time statistics
 	else if (choice == 2)
 	{
@@ -122,14 +89,14 @@ int main()
 		sort_menu();
 		cout << "Enter the choice: ";
 		cin >> choice;
-		while (choice < 1 || choice > 9)
+		while (choice < 1 || choice > 14)
 		{
 			cout << "Invalid input\n";
 			cout << "Enter the choice again: ";
 			cin >> choice;
 
 		}
-		if (choice != 9)
+		if (choice != 14)
 		{
 			// need to be fixed
 			int sortIndx = choice -1;
@@ -139,6 +106,52 @@ int main()
 			}
 		}
 	}
+	else if (choice == 4)
+	{
+		selection_statistics();
+	}
+	else if (choice == 5)
+	{
+		profile.tune();
+		if (profile.save (PROFILE_FILE))
+			cout << "Profile saved to " << PROFILE_FILE << endl;
+		else
+			cout << "Could not write " << PROFILE_FILE << endl;
+	}
+	else if (choice == 6)
+	{
+		int concurrency;
+		cout << "Enter the number of cells run at once (0 = one per core): ";
+		cin >> concurrency;
+		time_statistics (concurrency > 0 ? concurrency : 0);
+	}
+	else if (choice == 7)
+	{
+		incremental_statistics();
+	}
+	else if (choice == 8)
+	{
+		int workers;
+		cout << "Enter the number of worker processes: ";
+		cin >> workers;
+		sample_sort_statistics (workers);
+	}
+	else if (choice == 9)
+	{
+		memory_statistics();
+	}
+	else if (choice == 10)
+	{
+		quick_sort_profile();
+	}
+	else if (choice == 11)
+	{
+		sort_service_statistics();
+	}
+	else if (choice == 12)
+	{
+		insertion_statistics();
+	}
 	
 	cout << "Good bye!\n";
 	return 0;
@@ -146,7 +159,8 @@ int main()
 
 /**
  * @brief       sort() will take the array object (pass by value) and sort it
- *				with the selected sorting algorithm.
+ *				with the selected sorting algorithm. The result is checked by the
+ *				verifier after the sort's own clock has stopped.
  *
  * @param        numbers     Array object which will be sorted
  * @param        sortType    the enum which evokes the type of sort method
@@ -158,73 +172,663 @@ int main()
 pair<double,int> sort (Array numbers, int sortType)
 {
 	pair<double,int> record;
-	switch (sortType)
-	{
-		case SELECTION:
-			record = numbers.selectionSort();
-			break;
-		case BUBBLE:
-			record = numbers.bubbleSort();
-			break;
-		case INSERTION:
-			record = numbers.insertionSort();
-			break;
-		case MODINSERTION:
-			record = numbers.modifiedInsertionSort();
-			break;
-		case MERGE:
-			record = numbers.mergeSort();
-			break;
-		case QUICK:
-			record = numbers.quickSort();
-			break;
-		case RANQUICK:
-			record = numbers.randomizedQuickSort();
-			break;
-		case HEAP:
-			record = numbers.heapSort();
-			break;
-	} // end switch
+	if (sortType == AUTO)	// the chosen engine verifies its own copy
+		return sort (numbers, profile.choose (numbers));
+	unsigned long long hash = verifier.before (numbers);
+	record = numbers.sortBy (sortType, profile.getCutoff (sortType));
+	if (!verifier.after (numbers, hash))
+		cout << "Verification failed: " << SORT_NAMES[sortType] << endl;
 	return record;
 }	// end function sort
 
 void testing (Array numbers, int sortType, int orderType)
 {
+	if (sortType == AUTO)	// show which engine the profile picks
+	{
+		sortType = profile.choose (numbers);
+		cout << "\nAuto picked: " << SORT_NAMES[sortType] << endl;
+	}
 	cout << "\nBefore sorting: \n";
 	numbers.write (SORT_NAMES[sortType], ORDER_NAMES[orderType]);
 
-	switch (sortType)
-	{
-		case SELECTION:
-			numbers.selectionSort();
-			break;
-		case BUBBLE:
-			numbers.bubbleSort();
-			break;
-		case INSERTION:
-			numbers.insertionSort();
-			break;
-		case MODINSERTION:
-			numbers.modifiedInsertionSort();
-			break;
-		case MERGE:
-			numbers.mergeSort();
-			break;
-		case QUICK:
-			numbers.quickSort();
-			break;
-		case RANQUICK:
-			numbers.randomizedQuickSort();
-			break;
-		case HEAP:
-			numbers.heapSort();
-			break;
-	} // end switch
-	
+	numbers.sortBy (sortType, profile.getCutoff (sortType));
+
 	cout << "\nAfter sorting: \n";
 	numbers.write (SORT_NAMES[sortType], ORDER_NAMES[orderType]);
 }
 
+/**
+ * @brief       time_statistics() prints the time and comparison table of every sort
+ *				and order for the series of sizes 100, 1000, 10,000, 30,000. Each cell
+ *				is measured once; with a concurrency other than 1 the cells of a size
+ *				are run by the Scheduler on separate cores. The table is printed after
+ *				all cells of a size are measured, so it looks the same either way.
+ *
+ *				The whole sweep shares one time budget. Every cell keeps a complexity
+ *				model of its earlier sizes; a cell predicted to need more than what is
+ *				left of the budget is skipped, and its predicted time and comparison
+ *				count are shown with a leading '~' instead.
+ *
+ * @param        concurrency     the most cells run at once; 1 is serial, 0 is one per core
+**/
+void time_statistics (int concurrency)
+{
+	double epsilon = 0.0005;
+	int size = 100;			// starting size
+	int sizeLimit = 30000;	// size limit
+	int multiplier = 10;
+	double timeLimit = 60;	// budget of the whole sweep, in seconds
+	Scheduler scheduler (concurrency);
+	int parallel = (concurrency == 1) ? 1 : scheduler.getConcurrency();
+	ComplexityModel models[AUTO+1][3];
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	do
+	{
+		Array* a[3];	// allocate dynamic arrays
+		a[0] = new Array (size, RANDOM);
+		a[1] = new Array (size, IN_ORDER);
+		a[2] = new Array (size, REVERSE_ORDER);
+		double elapsed = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+		double planned = 0;		// predicted seconds of the cells that will run
+		// enum SORTS {SELECTION, BUBBLE, INSERTION, MODINSERTION, MERGE, QUICK, RANQUICK, HEAP,
+		//			   HYBRIDQUICK, HYBRIDMERGE, BININSERTION, BLOCKINSERTION, AUTO};
+		// enum ORDERS {RANDOM, IN_ORDER, REVERSE_ORDER}
+		vector<Cell> cells;
+		vector<bool> skipped;
+		vector<Cell> toRun;
+		for (int sortIndx = SELECTION; sortIndx <= AUTO; sortIndx++)
+			for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+			{
+				Cell cell;
+				cell.sortType = sortIndx;
+				cell.orderType = orderIndx;
+				double predicted = models[sortIndx][orderIndx].predictTime (size);
+				bool skip = elapsed + (planned + predicted) / parallel > timeLimit;
+				if (!skip)
+				{
+					planned += predicted;
+					toRun.push_back (cell);
+				}	// end if
+				cells.push_back (cell);
+				skipped.push_back (skip);
+			}	// end for orderIndx
+		if (concurrency == 1)
+		{
+			for (int i = 0; i < (int) toRun.size(); i++)
+				toRun[i].record = sort (*a[toRun[i].orderType], toRun[i].sortType);
+		}
+		else
+			scheduler.run (a, toRun, sort);
+		for (int i = 0, next = 0; i < (int) cells.size(); i++)
+			if (!skipped[i])
+			{
+				cells[i] = toRun[next++];
+				models[cells[i].sortType][cells[i].orderType].add (size, cells[i].record.first,
+																	 cells[i].record.second);
+			}	// end if
+
+		// Title of table
+		cout << setw(9) << size << setw(50) << "Random" << setw(20) << "Inorder" << setw(20) << "Reverse\n";
+		for (int i = 0; i < 100; ++i)
+			cout << '-';
+		cout << endl;
+		for (int sortIndx = SELECTION; sortIndx <= AUTO; sortIndx++)
+		{
+			const Cell* row = &cells[sortIndx * 3];
+			cout << SORT_NAMES[sortIndx] << setw(25) << "Time:              ";
+			for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+			{
+				double time = row[orderIndx].record.first;
+				if (skipped[sortIndx * 3 + orderIndx])	// extrapolated
+				{
+					std::ostringstream predicted;
+					predicted << '~' << setprecision(3) << setiosflags (ios::showpoint|ios::fixed)
+							  << models[sortIndx][orderIndx].predictTime (size);
+					cout << setw(20) << predicted.str();
+				}
+				else if (time > epsilon)
+					cout << setw(20) << setprecision(3) << setiosflags (ios::showpoint|ios::fixed)
+						 << time;
+				else	// avoid distracting display of decimals for very small times
+					cout << setw(20) << "0";
+			}	// end for orderIndx
+			cout << endl;
+			cout << "             " << setw(25) << "Comparision Count: ";
+			for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+			{
+				if (skipped[sortIndx * 3 + orderIndx])
+				{
+					std::ostringstream predicted;
+					predicted << '~' << (long long) models[sortIndx][orderIndx].predictComparisons (size);
+					cout << setw(20) << predicted.str();
+				}
+				else
+					cout << setw(20) << row[orderIndx].record.second;
+			}	// end for orderIndx
+			cout << endl;
+			for (int i = 0; i < 19; ++i)
+				cout << ' ';
+			for (int i = 0; i < 81; ++i)
+				cout << '-';
+			cout << endl;
+		}	// end for sortIndx
+		verifier.report();
+		verifier.reset();
+		cout << endl;
+		// free dynamic arrays 
+		for (int i = 0; i < 3; i++)
+		{
+			delete a[i];
+		}	// end for loop of setting dynamic arrays free
+		size *= multiplier;
+		multiplier = (size==10000) ? 3 : 10;	// alternate multiplier
+	}	// end do while
+	while (size <=sizeLimit);
+
+	// the fitted models: comparisons ~= c * model(n), time ~= n^exponent
+	cout << "Model fit" << setw(22) << "Order" << setw(12) << "Model" << setw(16) << "c"
+		 << setw(12) << "Exponent\n";
+	for (int i = 0; i < 70; ++i)
+		cout << '-';
+	cout << endl;
+	for (int sortIndx = SELECTION; sortIndx <= AUTO; sortIndx++)
+		for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+		{
+			const ComplexityModel& fit = models[sortIndx][orderIndx];
+			cout << SORT_NAMES[sortIndx] << setw(18) << ORDER_NAMES[orderIndx]
+				 << setw(12) << MODEL_NAMES[fit.getModel()]
+				 << setw(16) << setprecision(4) << fit.getConstant()
+				 << setw(11) << setprecision(2) << fit.getExponent() << endl;
+		}	// end for orderIndx
+}	// end function
+
+/**
+ * @brief       selection_statistics() compares the selection methods with a full
+ *				merge sort followed by taking the first k (or the quantile) positions.
+ *				Every run gets its own copy of the same random array, and every
+ *				result is checked against the verified full sort after its clock stops.
+**/
+void selection_statistics()
+{
+	const int SIZES = 4;
+	int sizes[SIZES] = {1000, 10000, 100000, 1000000};
+	const int RATIOS = 4;
+	double ratios[RATIOS] = {0.001, 0.01, 0.1, 0.5};
+	const int DECILES = 9;
+
+	cout << setw(9) << "Size" << setw(10) << "k/n" << setw(20) << "Full sort"
+		 << setw(20) << "nth_element" << setw(20) << "partial_sort\n";
+	for (int i = 0; i < 79; ++i)
+		cout << '-';
+	cout << endl;
+	for (int sizeIndx = 0; sizeIndx < SIZES; sizeIndx++)
+	{
+		int size = sizes[sizeIndx];
+		Array original (size, RANDOM);
+		Array sorted (original);
+		unsigned long long hash = verifier.before (original);
+		// the slice is free once sorted; merge sort, as the keys repeat and Lomuto quick sort degrades on them
+		pair<double,int> full = sorted.mergeSort();
+		if (!verifier.after (sorted, hash))
+			cout << "Verification failed: full sort\n";
+		for (int ratioIndx = 0; ratioIndx < RATIOS; ratioIndx++)
+		{
+			int k = (int) (size * ratios[ratioIndx]);
+			if (k < 1)
+				k = 1;
+			Array nth (original);
+			pair<double,int> nthRecord = nth.nthElement (k-1);
+			Array partial (original);
+			pair<double,int> partialRecord = partial.partialSort (k);
+			int rank = k-1;
+			if (!verifier.selected (nth, hash, sorted, &rank, 1))
+				cout << "Verification failed: nth_element\n";
+			if (!verifier.selected (partial, hash, sorted, NULL, k))
+				cout << "Verification failed: partial_sort\n";
+			cout << setw(9) << size << setw(10) << setprecision(3) << setiosflags (ios::showpoint|ios::fixed)
+				 << ratios[ratioIndx]
+				 << setw(20) << full.first << setw(20) << nthRecord.first << setw(20) << partialRecord.first << endl;
+			cout << setw(19) << "Comparisons:"
+				 << setw(20) << full.second << setw(20) << nthRecord.second << setw(20) << partialRecord.second << endl;
+		}	// end for ratioIndx
+
+		int ranks[DECILES];
+		for (int i = 0; i < DECILES; i++)
+			ranks[i] = (int) ((long long) size * (i+1) / (DECILES+1));
+		Array deciles (original);
+		pair<double,int> decileRecord = deciles.quantiles (ranks, DECILES);
+		if (!verifier.selected (deciles, hash, sorted, ranks, DECILES))
+			cout << "Verification failed: quantiles\n";
+		cout << setw(9) << size << setw(10) << "deciles"
+			 << setw(20) << full.first << setw(20) << decileRecord.first << endl;
+		cout << setw(19) << "Comparisons:"
+			 << setw(20) << full.second << setw(20) << decileRecord.second << endl;
+		cout << setw(19) << "Values:";
+		for (int i = 0; i < DECILES; i++)
+			cout << ' ' << deciles.getValue (ranks[i]);
+		cout << endl;
+		verifier.report();
+		verifier.reset();
+		cout << endl;
+	}	// end for sizeIndx
+}	// end function
+
+/**
+ * @brief       incremental_statistics() compares two ways of keeping a sorted array
+ *				while batches arrive: mergeBatch() against append() followed by a full
+ *				mergeSort(). After every batch a set of lower-bound and range queries
+ *				is run. The throughput of inserted values and of queries is reported.
+ *				The batches are made before the clock starts; the array is verified
+ *				after every batch, once the clock has stopped.
+ **/
+void incremental_statistics()
+{
+	const int BASE = 100000;			// sorted values before the first batch
+	const int KEYS = 1000000;			// key range of all values
+	const int BATCHES = 200;
+	const int QUERIES = 100;			// after each batch
+	const int BATCH_SIZES = 3;
+	int batchSizes[BATCH_SIZES] = {10, 100, 1000};
+
+	cout << setw(9) << "Batch" << setw(12) << "Mode" << setw(20) << "Inserts/s"
+		 << setw(20) << "Queries/s" << setw(16) << "Comparisons\n";
+	for (int i = 0; i < 76; ++i)
+		cout << '-';
+	cout << endl;
+	for (int b = 0; b < BATCH_SIZES; b++)
+	{
+		Array** batches = new Array* [BATCHES];
+		int* keys = new int [BATCHES * QUERIES];
+		for (int i = 0; i < BATCHES; i++)
+			batches[i] = new Array (batchSizes[b], RANDOM, KEYS);
+		for (int i = 0; i < BATCHES * QUERIES; i++)
+			keys[i] = rand() % KEYS;
+
+		for (int mode = 0; mode < 2; mode++)	// 0 = merge the batch, 1 = re-sort everything
+		{
+			Array numbers (BASE, RANDOM, KEYS);
+			unsigned long long hash = verifier.before (numbers);
+			numbers.mergeSort();
+			double insertTime = 0, queryTime = 0;
+			long long comparisons = 0;
+			long long found = 0;	// keeps the queries from being optimized away
+			for (int i = 0; i < BATCHES; i++)
+			{
+				hash += verifier.before (*batches[i]);	// the hash of a union is the sum
+				double start = threadClock();
+				if (mode == 0)
+					comparisons += numbers.mergeBatch (*batches[i]).second;
+				else
+				{
+					numbers.append (*batches[i]);
+					comparisons += numbers.mergeSort().second;
+				}	// end else
+				double middle = threadClock();
+				for (int q = 0; q < QUERIES; q++)
+				{
+					int key = keys[i * QUERIES + q];
+					found += numbers.upperBound (key + KEYS/1000) - numbers.lowerBound (key);
+				}	// end for queries
+				double finish = threadClock();
+				insertTime += middle - start;
+				queryTime += finish - middle;
+				if (!verifier.after (numbers, hash))
+					cout << "Verification failed: batch " << i << endl;
+			}	// end for batches
+			cout << setw(9) << batchSizes[b] << setw(12) << (mode == 0 ? "merge" : "re-sort")
+				 << setw(20) << setprecision(0) << setiosflags (ios::fixed)
+				 << (insertTime > 0 ? BATCHES * batchSizes[b] / insertTime : 0)
+				 << setw(20) << (queryTime > 0 ? BATCHES * QUERIES / queryTime : 0)
+				 << setw(15) << comparisons << endl;
+			if (found < 0)
+				cout << found;
+		}	// end for mode
+		verifier.report();
+		verifier.reset();
+
+		for (int i = 0; i < BATCHES; i++)
+			delete batches[i];
+		delete [] batches;
+		delete [] keys;
+	}	// end for batch sizes
+}	// end function
+
+/**
+ * @brief       sample_sort_statistics() runs the multi-process sample sort on random
+ *				arrays of growing size and prints each worker's report next to the
+ *				time of one process sorting the same array with the same engine.
+ *				Both totals are wall times.
+ *
+ * @param        workers     	the number of worker processes
+**/
+void sample_sort_statistics (int workers)
+{
+	const int SIZES = 3;
+	int sizes[SIZES] = {100000, 1000000, 10000000};
+	SampleSort sampleSort (workers, HYBRIDQUICK, profile.getInsertionCutoff());
+
+	for (int sizeIndx = 0; sizeIndx < SIZES; sizeIndx++)
+	{
+		Array original (sizes[sizeIndx], RANDOM, sizes[sizeIndx] * 4);
+		Array single (original);
+		// wall time, as for the sample sort; the copy into single is not counted
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		single.sortBy (HYBRIDQUICK, profile.getInsertionCutoff());
+		double singleTime = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+		Array numbers (original);
+		unsigned long long hash = verifier.before (numbers);
+		pair<double,int> record = sampleSort.sort (numbers);
+
+		cout << "\nSize " << sizes[sizeIndx] << ", " << workers << " workers, "
+			 << SORT_NAMES[HYBRIDQUICK] << endl;
+		if (record.first < 0)
+		{
+			cout << "The worker processes could not be started\n";
+			continue;
+		}	// end if
+		sampleSort.report();
+		if (!verifier.after (numbers, hash))
+			cout << "Verification failed: sample sort\n";
+		verifier.report();
+		verifier.reset();
+		cout << "Sample sort total: " << setprecision(6) << record.first
+			 << "   One process: " << singleTime << endl;
+	}	// end for sizeIndx
+}	// end function
+
+/**
+ * @brief       memory_statistics() prints, next to the time, how much memory each
+ *				sort needs for every order and the sizes 100 to 30,000: the peak of
+ *				its live heap, all bytes and calls to operator new, the deepest
+ *				recursion, and the growth of the peak resident set. The copy that
+ *				sort() gets by value is made before measuring; it adds 4 bytes per
+ *				element to every cell on top of what is shown. Each result is verified
+ *				outside the metered region. The heap rows and the depth need a build
+ *				with -DMEMORY_PROFILE; otherwise they show -1.
+**/
+void memory_statistics()
+{
+	const int SIZES = 4;
+	int sizes[SIZES] = {100, 1000, 10000, 30000};
+	const int ROWS = 6;
+	const string LABELS[ROWS] = {"Time:              ", "Peak heap bytes:   ", "Allocated bytes:   ",
+								 "Allocations:       ", "Max depth:         ", "Peak RSS +KB:      "};
+	MemoryMeter meter;
+#ifndef MEMORY_PROFILE
+	cout << "Heap counting and recursion depth are compiled out (shown as -1); rebuild with -DMEMORY_PROFILE\n";
+#endif
+
+	for (int sizeIndx = 0; sizeIndx < SIZES; sizeIndx++)
+	{
+		int size = sizes[sizeIndx];
+		Array* a[3];	// allocate dynamic arrays
+		a[0] = new Array (size, RANDOM);
+		a[1] = new Array (size, IN_ORDER);
+		a[2] = new Array (size, REVERSE_ORDER);
+
+		// Title of table
+		cout << setw(9) << size << setw(50) << "Random" << setw(20) << "Inorder" << setw(20) << "Reverse\n";
+		for (int i = 0; i < 100; ++i)
+			cout << '-';
+		cout << endl;
+		for (int sortIndx = SELECTION; sortIndx <= AUTO; sortIndx++)
+		{
+			double values[ROWS][3];
+			for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+			{
+				Array numbers (*a[orderIndx]);
+				int engine = (sortIndx == AUTO) ? profile.choose (numbers) : sortIndx;
+				unsigned long long hash = verifier.before (numbers);
+				meter.start();
+				pair<double,int> record = numbers.sortBy (engine, profile.getCutoff (engine));
+				MemoryUsage usage = meter.stop();
+				if (!verifier.after (numbers, hash))
+					cout << "Verification failed: " << SORT_NAMES[engine] << endl;
+				values[0][orderIndx] = record.first;
+				values[1][orderIndx] = usage.peakBytes;
+				values[2][orderIndx] = usage.totalBytes;
+				values[3][orderIndx] = usage.allocations;
+				values[4][orderIndx] = numbers.getMaxDepth();
+				values[5][orderIndx] = usage.peakRssKB;
+			}	// end for orderIndx
+			for (int row = 0; row < ROWS; row++)
+			{
+				cout << (row == 0 ? SORT_NAMES[sortIndx] : "             ") << setw(25) << LABELS[row];
+				for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+				{
+					if (row == 0)
+						cout << setw(20) << setprecision(3) << setiosflags (ios::showpoint|ios::fixed)
+							 << values[row][orderIndx];
+					else
+						cout << setw(20) << (long long) values[row][orderIndx];
+				}	// end for orderIndx
+				cout << endl;
+			}	// end for rows
+			for (int i = 0; i < 19; ++i)
+				cout << ' ';
+			for (int i = 0; i < 81; ++i)
+				cout << '-';
+			cout << endl;
+		}	// end for sortIndx
+		verifier.report();
+		verifier.reset();
+		cout << endl;
+		// free dynamic arrays 
+		for (int i = 0; i < 3; i++)
+		{
+			delete a[i];
+		}	// end for loop of setting dynamic arrays free
+	}	// end for sizeIndx
+}	// end function
+
+/**
+ * @brief       quick_sort_profile() traces quickSort() and randomizedQuickSort() on
+ *				every order at 1000 and 10,000 elements, prints each profile and
+ *				writes them all as folded stacks to quicksort.folded. The tracing
+ *				exists only in a build with -DQUICKSORT_PROFILE.
+**/
+void quick_sort_profile()
+{
+#ifdef QUICKSORT_PROFILE
+	const int SIZES = 2;
+	int sizes[SIZES] = {1000, 10000};
+	const string FOLDED_FILE = "quicksort.folded";
+	ofstream folded (FOLDED_FILE.c_str());
+
+	for (int sizeIndx = 0; sizeIndx < SIZES; sizeIndx++)
+		for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+		{
+			Array original (sizes[sizeIndx], orderIndx);
+			for (int sortIndx = QUICK; sortIndx <= RANQUICK; sortIndx++)
+			{
+				Array numbers (original);
+				QuickProfile::current().reset();
+				pair<double,int> record = (sortIndx == QUICK) ? numbers.quickSort()
+															  : numbers.randomizedQuickSort();
+				cout << '\n' << SORT_NAMES[sortIndx] << ORDER_NAMES[orderIndx] << setw(9) << sizes[sizeIndx]
+					 << "   Comparisons: " << record.second << endl;
+				QuickProfile::current().report (cout);
+
+				std::ostringstream root;
+				root << (sortIndx == QUICK ? "Quick" : "RanQuick") << '_'
+					 << (orderIndx == RANDOM ? "Random" : orderIndx == IN_ORDER ? "InOrder" : "Reverse")
+					 << '_' << sizes[sizeIndx];
+				QuickProfile::current().writeFolded (folded, root.str(),
+													 sortIndx == QUICK ? "quickSort" : "randomizedQuickSort");
+			}	// end for sortIndx
+		}	// end for orderIndx
+	cout << "\nFolded stacks written to " << FOLDED_FILE << endl;
+#else
+	cout << "Quick sort tracing is compiled out; rebuild with -DQUICKSORT_PROFILE\n";
+#endif
+}	// end function
+
+/**
+ * @brief       sort_service_statistics() starts the sort service in a child process
+ *				and runs the load generator against it: for each request size and
+ *				number of client processes, every client sends a series of AUTO
+ *				requests and times each one from send to reply. The throughput of
+ *				all clients and the median and 99th percentile latency are printed.
+**/
+void sort_service_statistics()
+{
+	const int REQUEST_SIZES = 3;
+	int requestSizes[REQUEST_SIZES] = {16, 256, 4096};
+	const int CLIENT_COUNTS = 3;
+	int clientCounts[CLIENT_COUNTS] = {1, 4, 16};
+	std::ostringstream path;
+	path << "/tmp/sort-service-" << getpid() << ".sock";
+
+	cout.flush();
+	pid_t server = fork();
+	if (server < 0)
+	{
+		perror ("fork");
+		return;
+	}	// end if
+	if (server == 0)	// the service process
+	{
+		int threads = (int) std::thread::hardware_concurrency();
+		SortService service (path.str(), profile, threads > 0 ? threads : 1, 32, 200);
+		_exit (service.run() ? 0 : 1);
+	}	// end if
+
+	{
+		// Wait until the service is listening. The probe hangs up again: an idle
+		// connection would keep the service waiting for it to join each batch.
+		SortClient probe;
+		for (int attempt = 0; attempt < 200 && !probe.connect (path.str(), 1); attempt++)
+			usleep (10000);
+	}
+
+	cout << setw(9) << "Size" << setw(10) << "Clients" << setw(16) << "Requests/s"
+		 << setw(14) << "p50 us" << setw(14) << "p99 us" << setw(10) << "Failed\n";
+	for (int i = 0; i < 72; ++i)
+		cout << '-';
+	cout << endl;
+	for (int sizeIndx = 0; sizeIndx < REQUEST_SIZES; sizeIndx++)
+		for (int clientIndx = 0; clientIndx < CLIENT_COUNTS; clientIndx++)
+		{
+			int size = requestSizes[sizeIndx];
+			int clients = clientCounts[clientIndx];
+			int perClient = 400000 / size;
+			if (perClient > 2000)
+				perClient = 2000;
+			else if (perClient < 200)
+				perClient = 200;
+			int total = clients * perClient;
+			// latencies in nanoseconds (-1 for a failed request), written by the clients
+			int* latencies = (int*) mmap (NULL, total * sizeof (int), PROT_READ | PROT_WRITE,
+										  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (latencies == MAP_FAILED)
+			{
+				perror ("mmap");
+				continue;
+			}	// end if
+
+			cout.flush();
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			vector<pid_t> children;
+			for (int c = 0; c < clients; c++)
+			{
+				pid_t pid = fork();
+				if (pid == 0)	// a producer process
+				{
+					int* mine = &latencies[c * perClient];
+					SortClient client;
+					bool connected = client.connect (path.str(), size);
+					unsigned int seed = 17 + c;
+					for (int r = 0; r < perClient; r++)
+					{
+						mine[r] = -1;
+						if (!connected)
+							continue;
+						for (int i = 0; i < size; i++)
+							client.buffer()[i] = rand_r (&seed) % 1000;
+						ServiceReply reply;
+						std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+						bool sorted = client.sort (size, AUTO, reply);
+						long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>
+												(std::chrono::steady_clock::now() - sent).count();
+						if (sorted && Array (client.buffer(), size).isSorted())
+							mine[r] = (int) (nanoseconds < 2000000000LL ? nanoseconds : 2000000000LL);
+					}	// end for requests
+					_exit (0);
+				}	// end if
+				if (pid > 0)
+					children.push_back (pid);
+			}	// end for clients
+			for (int i = 0; i < (int) children.size(); i++)
+				waitpid (children[i], NULL, 0);
+			double wall = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+
+			vector<int> succeeded;
+			for (int i = 0; i < total; i++)
+				if (latencies[i] >= 0)
+					succeeded.push_back (latencies[i]);
+			munmap (latencies, total * sizeof (int));
+			int failed = total - (int) succeeded.size();
+			double p50 = 0, p99 = 0;
+			if (!succeeded.empty())
+			{
+				Array times (&succeeded[0], (int) succeeded.size());
+				int ranks[2] = {(int) (succeeded.size() * 50 / 100), (int) (succeeded.size() * 99 / 100)};
+				times.quantiles (ranks, 2);
+				p50 = times.getValue (ranks[0]) / 1000.0;
+				p99 = times.getValue (ranks[1]) / 1000.0;
+			}	// end if
+			cout << setw(9) << size << setw(10) << clients
+				 << setw(16) << setprecision(0) << setiosflags (ios::fixed) << succeeded.size() / wall
+				 << setw(14) << setprecision(1) << p50 << setw(14) << p99 << setw(9) << failed << endl;
+		}	// end for clientIndx
+
+	SortClient control;
+	if (control.connect (path.str(), 1))
+		control.stopService();
+	waitpid (server, NULL, 0);
+}	// end function
+
+/**
+ * @brief       insertion_statistics() compares the three binary-search insertion
+ *				sorts on every order for the sizes 1000, 10,000 and 30,000. Besides
+ *				time and comparisons it shows the element moves per element, which
+ *				is where the engines differ: the modified and binary insertion sorts
+ *				move O(n) elements per insert, the block insertion sort O(sqrt(n)).
+**/
+void insertion_statistics()
+{
+	const int ENGINES = 3;
+	int engines[ENGINES] = {MODINSERTION, BININSERTION, BLOCKINSERTION};
+
+	cout << setw(9) << "Size" << setw(16) << "Sort" << setw(16) << "Order" << setw(12) << "Time"
+		 << setw(14) << "Comparisons" << setw(14) << "Moves/elem" << endl;
+	for (int i = 0; i < 81; ++i)
+		cout << '-';
+	cout << endl;
+	for (int size = 1000; size <= 30000; size = (size == 10000) ? 30000 : size * 10)
+	{
+		for (int orderIndx = RANDOM; orderIndx <= REVERSE_ORDER; orderIndx++)
+		{
+			Array original (size, orderIndx);
+			for (int e = 0; e < ENGINES; e++)
+			{
+				Array numbers (original);
+				unsigned long long hash = verifier.before (numbers);
+				pair<double,int> record = numbers.sortBy (engines[e], 0);
+				if (!verifier.after (numbers, hash))
+					cout << "Verification failed: " << SORT_NAMES[engines[e]] << endl;
+				cout << setw(9) << size << setw(16) << SORT_NAMES[engines[e]] << setw(16) << ORDER_NAMES[orderIndx]
+					 << setw(12) << setprecision(4) << setiosflags (ios::fixed) << record.first
+					 << setw(14) << record.second
+					 << setw(14) << setprecision(1) << (double) numbers.getMoves() / size << endl;
+			}	// end for e
+		}	// end for orderIndx
+		verifier.report();
+		verifier.reset();
+		cout << endl;
+	}	// end for size
+}	// end function
+
 void main_menu()
 {
 	cout << "******************************************" << endl; 
@@ -232,7 +836,16 @@ void main_menu()
 	cout << "*  1. Time execution statistics          *" << endl;
 	cout << "*  2. Comparision execution statistics   *" << endl;
 	cout << "*  3. Testing sort                       *" << endl;
-	cout << "*  4. Exit                               *" << endl;
+	cout << "*  4. Selection statistics               *" << endl;
+	cout << "*  5. Autotune this machine              *" << endl;
+	cout << "*  6. Parallel time statistics           *" << endl;
+	cout << "*  7. Incremental insert statistics      *" << endl;
+	cout << "*  8. Sample sort statistics             *" << endl;
+	cout << "*  9. Memory statistics                  *" << endl;
+	cout << "* 10. Quick sort profile                 *" << endl;
+	cout << "* 11. Sort service load test             *" << endl;
+	cout << "* 12. Insertion sort statistics          *" << endl;
+	cout << "* 13. Exit                               *" << endl;
 	cout << "******************************************" << endl; 
 }
 
@@ -248,6 +861,11 @@ void sort_menu()
 	cout << "*  6. Quick Sort                         *" << endl;
 	cout << "*  7. Randomized Quick Sort              *" << endl;
 	cout << "*  8. Heap Sort                          *" << endl;
-	cout << "*  9. Exit                               *" << endl;
+	cout << "*  9. Hybrid Quick Sort                  *" << endl;
+	cout << "* 10. Hybrid Merge Sort                  *" << endl;
+	cout << "* 11. Binary Insertion Sort              *" << endl;
+	cout << "* 12. Block Insertion Sort               *" << endl;
+	cout << "* 13. Auto (tuned engine)                *" << endl;
+	cout << "* 14. Exit                               *" << endl;
 	cout << "******************************************" << endl; 
 }
\ No newline at end of file